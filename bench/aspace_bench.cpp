@@ -0,0 +1,198 @@
+/***********************************************************************************
+ *                              [SIMULATION BENCH]
+ * @brief Runs World::step headless and reports per-phase timing percentiles.
+ * @details No window, no textures: ships are built around a size-only
+ *          Texture2D (id 0, nothing on the GPU), so only the simulation is
+ *          measured – entity update, grid maintenance, broad-phase, SAT and
+ *          resolution, exactly as World::step splits them.
+ * @details Each scenario (layout × broad-phase) prints ONE line of JSON on
+ *          stdout, percentiles in microseconds per tick, so runs can be
+ *          diffed / tracked by a script. Progress goes to stderr.
+ *          Run from the directory holding rsc/ (the dreads' .ashape).
+ *
+ * Usage:  Aspace_bench [--ships N] [--dreads N] [--ticks N] [--warmup N]
+ *                      [--threads N] [--seed N]
+ *                      [--layout uniform|clustered|all]
+ *                      [--grid uniform|flat|sap|all]
+ ************************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "world.hpp"
+#include "basicship.hpp"
+#include "blb63dreadnaught.hpp"
+#include "rng.hpp"
+#include "simdkernels.hpp"
+
+namespace {
+
+enum class Layout { Uniform, Clustered };
+
+struct Options
+{
+    int      ships   = 2000;
+    int      dreads  = 200;
+    int      ticks   = 600;
+    int      warmup  = 60;
+    unsigned threads = 0;           // 0 = hardware threads
+    uint64_t seed    = 1;
+    std::string layout = "all";
+    std::string grid   = "all";
+};
+
+// size-only stand-ins: the constructors read width / height, nothing is uploaded
+const Texture2D kShipTex  { 0, 144, 144, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };   // Main Ship hull ×3
+const Texture2D kDreadTex { 0, 492, 742, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };   // BLB63dreadnaught.png
+
+constexpr float W = World::WORLD_W, H = World::WORLD_H;
+constexpr Vector2 kScreen { 1920, 1080 };
+
+Vector2 Place(Layout layout, Pcg32& rng, int i)
+{
+    if (layout == Layout::Uniform) return { rng.range(64, W - 64), rng.range(64, H - 64) };
+
+    // clustered: 4 fleets, everybody within ~1500 units of one of them
+    static const Vector2 fleets[4] = { {W*0.2f, H*0.3f}, {W*0.7f, H*0.25f}, {W*0.4f, H*0.7f}, {W*0.8f, H*0.8f} };
+    const Vector2 c = fleets[i % 4];
+    const float   r = 1500.0f * std::sqrt(rng.nextFloat());   // uniform over the disc
+    const float   a = rng.range(0, 2 * PI);
+    return { std::clamp(c.x + r * std::cos(a), 64.f, W - 64), std::clamp(c.y + r * std::sin(a), 64.f, H - 64) };
+}
+
+struct Percentiles { double p50, p90, p99, max, mean; };
+
+Percentiles Summarise(std::vector<double>& us)
+{
+    std::sort(us.begin(), us.end());
+    auto rank = [&](double q) { return us[std::min(us.size() - 1, size_t(q * double(us.size())))]; };
+    double sum = 0;
+    for (double v : us) sum += v;
+    return { rank(0.50), rank(0.90), rank(0.99), us.back(), sum / double(us.size()) };
+}
+
+void PrintPhase(const char* name, std::vector<double>& us, bool last)
+{
+    const Percentiles p = Summarise(us);
+    std::printf("\"%s\":{\"p50\":%.1f,\"p90\":%.1f,\"p99\":%.1f,\"max\":%.1f,\"mean\":%.1f}%s",
+                name, p.p50, p.p90, p.p99, p.max, p.mean, last ? "" : ",");
+}
+
+template<typename GridT>
+void Run(const char* gridName, Layout layout, const Options& opt)
+{
+    BasicWorld<GridT> world;
+    world.setThreadCount(opt.threads);
+    world.setSeed(opt.seed);
+
+    Pcg32 rng(opt.seed, 0xbe7c4);
+    std::vector<BasicShip*> ships;
+    ships.reserve(size_t(opt.ships));
+    for (int i = 0; i < opt.ships; ++i)
+    {
+        BasicShip& s = world.template spawn<BasicShip>(Place(layout, rng, i), kShipTex);
+        s.setTarget(Place(layout, rng, i));
+        ships.push_back(&s);
+    }
+    for (int i = 0; i < opt.dreads; ++i)
+        world.template spawn<BLB63DreadNaught>(Place(layout, rng, i), kDreadTex);
+
+    // the camera decides who is "near" for AI LOD: park it on the world centre
+    world.cameraController().update(0.0f, { W * 0.5f, H * 0.5f }, kScreen);
+
+    InputState input;
+    input.screenSize = kScreen;
+    const float dt = world.tickDt();
+
+    std::vector<double> update, grid, broad, narrow, resolve, total;
+    for (auto* v : { &update, &grid, &broad, &narrow, &resolve, &total }) v->reserve(size_t(opt.ticks));
+    size_t pairSum = 0, contactSum = 0;
+
+    for (int tick = 0; tick < opt.warmup + opt.ticks; ++tick)
+    {
+        // fighters wander: a fresh waypoint for a few of them every tick
+        for (size_t k = size_t(tick) % 64; k < ships.size(); k += 64)
+            if (tick % 2 == 0) ships[k]->setTarget(Place(layout, rng, int(k)));
+
+        world.step(dt, input);
+        if (tick < opt.warmup) continue;
+
+        const StepTimings& t = world.lastStepTimings();
+        update .push_back(t.update      * 1e6);
+        grid   .push_back(t.grid        * 1e6);
+        broad  .push_back(t.broadphase  * 1e6);
+        narrow .push_back(t.narrowphase * 1e6);
+        resolve.push_back(t.resolve     * 1e6);
+        total  .push_back(t.total()     * 1e6);
+        pairSum += world.potentialPairs().size();
+        for (const ContactManifold& c : world.pairContacts()) contactSum += c.contacts ? 1 : 0;
+    }
+
+    const double n = double(std::max(opt.ticks, 1));
+    std::printf("{\"grid\":\"%s\",\"layout\":\"%s\",\"ships\":%d,\"dreads\":%d,\"threads\":%u,\"simd\":\"%s\","
+                "\"ticks\":%d,\"tick_hz\":%.0f,\"pairs\":%.1f,\"contacts\":%.1f,\"unit\":\"us\",\"phases\":{",
+                gridName, layout == Layout::Uniform ? "uniform" : "clustered",
+                opt.ships, opt.dreads, world.threadCount(), simd::BackendName(), opt.ticks, world.tickRate(),
+                double(pairSum) / n, double(contactSum) / n);
+    PrintPhase("update",      update,  false);
+    PrintPhase("grid",        grid,    false);
+    PrintPhase("broadphase",  broad,   false);
+    PrintPhase("narrowphase", narrow,  false);
+    PrintPhase("resolve",     resolve, false);
+    PrintPhase("total",       total,   true);
+    std::printf("}}\n");
+    std::fflush(stdout);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        auto num = [&](auto& out) { if (!v) return false; out = decltype(out + 0)(std::strtoull(v, nullptr, 10)); ++i; return true; };
+        bool ok = true;
+        if      (!std::strcmp(a, "--ships"))   ok = num(opt.ships);
+        else if (!std::strcmp(a, "--dreads"))  ok = num(opt.dreads);
+        else if (!std::strcmp(a, "--ticks"))   ok = num(opt.ticks);
+        else if (!std::strcmp(a, "--warmup"))  ok = num(opt.warmup);
+        else if (!std::strcmp(a, "--threads")) ok = num(opt.threads);
+        else if (!std::strcmp(a, "--seed"))    ok = num(opt.seed);
+        else if (!std::strcmp(a, "--layout") && v) { opt.layout = v; ++i; }
+        else if (!std::strcmp(a, "--grid")   && v) { opt.grid   = v; ++i; }
+        else ok = false;
+        if (!ok) return false;
+    }
+    return opt.ticks > 0 && opt.ships >= 0 && opt.dreads >= 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    Options opt;
+    if (!ParseArgs(argc, argv, opt))
+    {
+        std::fprintf(stderr, "usage: %s [--ships N] [--dreads N] [--ticks N] [--warmup N] [--threads N] [--seed N]\n"
+                             "          [--layout uniform|clustered|all] [--grid uniform|flat|sap|all]\n", argv[0]);
+        return 2;
+    }
+
+    for (Layout layout : { Layout::Uniform, Layout::Clustered })
+    {
+        const char* lname = layout == Layout::Uniform ? "uniform" : "clustered";
+        if (opt.layout != "all" && opt.layout != lname) continue;
+
+        std::fprintf(stderr, "bench: %s, %d ships + %d dreads, %d ticks\n", lname, opt.ships, opt.dreads, opt.ticks);
+        if (opt.grid == "all" || opt.grid == "uniform") Run<UniformGrid>  ("uniform", layout, opt);
+        if (opt.grid == "all" || opt.grid == "flat")    Run<FlatGrid>     ("flat",    layout, opt);
+        if (opt.grid == "all" || opt.grid == "sap")     Run<SweepAndPrune>("sap",     layout, opt);
+    }
+    return 0;
+}
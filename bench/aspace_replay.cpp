@@ -0,0 +1,397 @@
+/***********************************************************************************
+ *                              [REPLAY / STRESS HARNESS]
+ * @brief Records a headless stress run into a replay log, and replays logs
+ *        tick by tick against their recorded state hashes.
+ * @details record: a pile-up scenario on World::update – player-style ships
+ *          chasing a scripted mouse through a crowd of fixed-target ships and
+ *          wandering dreads, the camera (and with it the AI LOD) following
+ *          the lead ship, jittered frame times (1–3 ticks a frame), and a
+ *          despawn + respawn every few hundred ticks to exercise slot reuse.
+ *          The game writes the same kind of log with `Aspace --record <file>`.
+ * @details play: rebuilds the world from the log with size-only textures and
+ *          steps it, printing ONE line of JSON: the first tick whose state
+ *          hash differs from the recording (-1 = bit-identical), the mismatch
+ *          count and per-phase step timings like Aspace_bench. Replaying one
+ *          log with --threads 1 or from a build with another ASPACE_ARCH
+ *          checks that path against the recording frame by frame; the fixed
+ *          workload also makes timings comparable across commits. Exit code 1
+ *          on divergence. --reference times the reference SAT path only: it
+ *          breaks ties between equally deep axes differently, so its hashes
+ *          are not expected to match and it never fails the run.
+ * @details compare: steps two worlds through one log in lockstep – A as
+ *          recorded, B with --threads – and reports the first tick they
+ *          differ and how far apart (world units) they drift. --reference
+ *          adds a narrow-phase check on A: after every tick each of its
+ *          broad-phase pairs is tested by both SAT paths on the same state,
+ *          comparing hit / miss and depth (normals may differ on ties).
+ *          Run from the directory holding rsc/ (the dreads' .ashape).
+ *
+ * Usage:  Aspace_replay record <out.areplay> [--ships N] [--dreads N] [--ticks N]
+ *                              [--seed N] [--threads N] [--grid uniform|flat|sap]
+ *         Aspace_replay play <log.areplay> [--threads N] [--reference]
+ *         Aspace_replay compare <log.areplay> [--threads N] [--reference]
+ ************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "replayplayer.hpp"
+#include "basicship.hpp"
+#include "blb63dreadnaught.hpp"
+#include "rng.hpp"
+#include "simdkernels.hpp"
+
+namespace {
+
+struct Options
+{
+    std::string mode, path;
+    int      ships     = 1500;
+    int      dreads    = 150;
+    int      ticks     = 1200;
+    unsigned threads   = 0;          // 0 = hardware threads
+    uint64_t seed      = 1;
+    std::string grid   = "uniform";
+    bool     reference = false;
+};
+
+const Texture2D kShipTex  { 0, 144, 144, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };   // Main Ship hull ×3
+const Texture2D kDreadTex { 0, 492, 742, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };   // BLB63dreadnaught.png
+
+constexpr float W = World::WORLD_W, H = World::WORLD_H;
+constexpr Vector2 kScreen { 1920, 1080 };
+
+/* ---- record ------------------------------------------------------------ */
+template<typename GridT>
+int Record(const Options& opt)
+{
+    ReplayRecorder rec;
+    BasicWorld<GridT> world;
+    world.setThreadCount(opt.threads);
+    world.setSeed(opt.seed);
+    world.record(&rec);
+
+    Pcg32 rng(opt.seed, 0x5e1ec7);
+    auto anywhere = [&] { return Vector2{ rng.range(64, W - 64), rng.range(64, H - 64) }; };
+    auto addShip  = [&](int i) {
+        BasicShip& s = world.template spawn<BasicShip>(anywhere(), kShipTex);
+        if (i % 4 == 0) s.setMouseSteering(true);   // the pile-up around the cursor
+        else            s.setTarget(anywhere());
+        return &s;
+    };
+
+    BasicShip* lead = opt.ships > 0 ? addShip(0) : nullptr;
+    for (int i = 1; i < opt.ships; ++i) addShip(i);
+    std::vector<EntityHandle> dreads;
+    for (int i = 0; i < opt.dreads; ++i)
+        dreads.push_back(world.template spawn<BLB63DreadNaught>(anywhere(), kDreadTex).handle());
+    world.setCameraTarget(lead);
+
+    InputState input;
+    input.screenSize  = kScreen;
+    input.mouseScreen = { kScreen.x * 0.5f, kScreen.y * 0.5f };
+    float    time = 0.0f;
+    uint64_t nextChurn = 300;
+    while (world.tickIndex() < uint64_t(opt.ticks))
+    {
+        // 1/60 s ± 40 %: some frames run one tick, some two or three
+        const float frameDt = (1.0f / 60.0f) * rng.range(0.6f, 1.4f);
+        time += frameDt;
+
+        // the cursor sweeps a Lissajous curve over most of the world, boost on 1 s in 3
+        input.mouseWorld = { W * (0.5f + 0.4f * std::sin(time * 0.21f)), H * (0.5f + 0.4f * std::sin(time * 0.33f + 1.0f)) };
+        input.mouseLeft  = std::fmod(time, 3.0f) < 1.0f;
+
+        world.update(frameDt, input);
+
+        if (world.tickIndex() >= nextChurn && !dreads.empty())
+        {
+            nextChurn += 300;
+            const size_t k = rng.next() % dreads.size();
+            world.despawn(dreads[k]);
+            dreads[k] = world.template spawn<BLB63DreadNaught>(anywhere(), kDreadTex).handle();
+            addShip(int(rng.next() % 4));
+        }
+    }
+
+    if (rec.unreplayable() > 0) std::fprintf(stderr, "replay: %zu spawns cannot be replayed\n", rec.unreplayable());
+    if (!rec.save(opt.path)) return 2;
+    std::printf("{\"recorded\":\"%s\",\"grid\":\"%s\",\"ships\":%d,\"dreads\":%d,\"threads\":%u,\"simd\":\"%s\","
+                "\"ticks\":%llu,\"bytes\":%zu,\"entities\":%zu}\n",
+                opt.path.c_str(), GridT::NAME, opt.ships, opt.dreads, world.threadCount(), simd::BackendName(),
+                (unsigned long long)rec.ticks(), rec.bytes(), world.entityCount());
+    return 0;
+}
+
+/* ---- play -------------------------------------------------------------- */
+struct Percentiles { double p50, p90, p99, max, mean; };
+
+Percentiles Summarise(std::vector<double>& us)
+{
+    if (us.empty()) return {};
+    std::sort(us.begin(), us.end());
+    auto rank = [&](double q) { return us[std::min(us.size() - 1, size_t(q * double(us.size())))]; };
+    double sum = 0;
+    for (double v : us) sum += v;
+    return { rank(0.50), rank(0.90), rank(0.99), us.back(), sum / double(us.size()) };
+}
+
+void PrintPhase(const char* name, std::vector<double>& us, bool last)
+{
+    const Percentiles p = Summarise(us);
+    std::printf("\"%s\":{\"p50\":%.1f,\"p90\":%.1f,\"p99\":%.1f,\"max\":%.1f,\"mean\":%.1f}%s",
+                name, p.p50, p.p90, p.p99, p.max, p.mean, last ? "" : ",");
+}
+
+template<typename GridT>
+void AddKinds(BasicReplayPlayer<GridT>& player)
+{
+    player.template addKind<BasicShip>();
+    player.template addKind<BLB63DreadNaught>();
+}
+
+template<typename GridT>
+int Play(const ReplayLog& log, const Options& opt)
+{
+    BasicWorld<GridT> world;
+    world.setThreadCount(opt.threads);
+    CollisionSystem::SetReferenceSAT(opt.reference);
+
+    BasicReplayPlayer<GridT> player;
+    AddKinds(player);
+    if (!player.start(log, world)) {
+        std::fprintf(stderr, "replay: %s\n", player.error().c_str());
+        return 2;
+    }
+
+    std::vector<double> update, grid, broad, narrow, resolve, total;
+    for (auto* v : { &update, &grid, &broad, &narrow, &resolve, &total }) v->reserve(size_t(log.ticks));
+    while (player.next())
+    {
+        if (!player.lastMatched() && player.mismatches() <= 5)
+            std::fprintf(stderr, "replay: tick %llu hash %016llx, recorded %016llx\n",
+                         (unsigned long long)(world.tickIndex() - 1),
+                         (unsigned long long)player.replayedHash(), (unsigned long long)player.recordedHash());
+
+        const StepTimings& t = world.lastStepTimings();
+        update .push_back(t.update      * 1e6);
+        grid   .push_back(t.grid        * 1e6);
+        broad  .push_back(t.broadphase  * 1e6);
+        narrow .push_back(t.narrowphase * 1e6);
+        resolve.push_back(t.resolve     * 1e6);
+        total  .push_back(t.total()     * 1e6);
+    }
+    if (!player.error().empty()) {
+        std::fprintf(stderr, "replay: %s\n", player.error().c_str());
+        return 2;
+    }
+
+    std::printf("{\"log\":\"%s\",\"grid\":\"%s\",\"ticks\":%llu,\"threads\":%u,\"simd\":\"%s\",\"sat\":\"%s\","
+                "\"recorded\":{\"ticks\":%llu,\"threads\":%u,\"simd\":\"%s\"},"
+                "\"diverged_at\":%lld,\"mismatches\":%llu,\"unit\":\"us\",\"phases\":{",
+                opt.path.c_str(), GridT::NAME, (unsigned long long)player.ticks(), world.threadCount(),
+                simd::BackendName(), opt.reference ? "reference" : "cached",
+                (unsigned long long)log.ticks, log.threads, log.simd.c_str(),
+                (long long)player.firstDivergence(), (unsigned long long)player.mismatches());
+    PrintPhase("update",      update,  false);
+    PrintPhase("grid",        grid,    false);
+    PrintPhase("broadphase",  broad,   false);
+    PrintPhase("narrowphase", narrow,  false);
+    PrintPhase("resolve",     resolve, false);
+    PrintPhase("total",       total,   true);
+    std::printf("}}\n");
+    std::fflush(stdout);
+
+    if (player.ticks() != log.ticks) {
+        std::fprintf(stderr, "replay: log ended after %llu of %llu ticks\n",
+                     (unsigned long long)player.ticks(), (unsigned long long)log.ticks);
+        return 2;
+    }
+    return (player.mismatches() == 0 || opt.reference) ? 0 : 1;
+}
+
+/* ---- compare ----------------------------------------------------------- */
+// both SAT paths over one world's broad-phase pairs, on the same state
+struct NarrowCheck
+{
+    // world units: float projections at x ~ 16k are good to ~2e-3, and the
+    // near-parallel axis merge (|dot| > 0.999) may keep the other edge of
+    // a pair – a tenth of a pixel, far below a real miss or wrong depth
+    static constexpr float DEPTH_TOL = 0.1f;
+
+    uint64_t pairs = 0, hitMismatches = 0, axisTies = 0;
+    double   maxDepthError = 0.0;
+    int64_t  firstBad = -1;
+
+    template<typename GridT>
+    void run(const BasicWorld<GridT>& world, int64_t tick)
+    {
+        for (const EntityPair& p : world.potentialPairs())
+        {
+            if (!p.a->isAliveAndCollidable() || !p.b->isAliveAndCollidable()) continue;
+            ContactManifold cached, ref;
+            CollisionSystem::SetReferenceSAT(false);
+            const bool hitC = CollisionSystem::CheckShapesCollide(p.a->collider(), p.b->collider(), cached);
+            CollisionSystem::SetReferenceSAT(true);
+            const bool hitR = CollisionSystem::CheckShapesCollide(p.a->collider(), p.b->collider(), ref);
+            CollisionSystem::SetReferenceSAT(false);
+            ++pairs;
+
+            bool bad = false;
+            if (hitC != hitR) {
+                // grazing contacts may fall either way within rounding
+                bad = std::max(cached.depth, ref.depth) > DEPTH_TOL;
+                hitMismatches += bad;
+            } else if (hitC) {
+                const double err = std::fabs(double(cached.depth) - ref.depth);
+                maxDepthError = std::max(maxDepthError, err);
+                bad = err > DEPTH_TOL;
+                const float dot = cached.normal.x * ref.normal.x + cached.normal.y * ref.normal.y;
+                if (!bad && dot < 0.9999f) ++axisTies;
+            }
+            if (bad && firstBad < 0) {
+                firstBad = tick;
+                std::fprintf(stderr, "replay: tick %lld: entities %u / %u: cached %s depth %.6g, reference %s depth %.6g\n",
+                             (long long)tick, p.a->handle().index, p.b->handle().index,
+                             hitC ? "hit" : "miss", double(cached.depth), hitR ? "hit" : "miss", double(ref.depth));
+            }
+        }
+    }
+    bool ok() const { return firstBad < 0; }
+};
+
+template<typename GridT>
+int Compare(const ReplayLog& log, const Options& opt)
+{
+    // A: as recorded (thread count of the recording, cached SAT); B: this run's thread count.
+    // Free-running worlds on two SAT paths part at the first tied axis, so
+    // --reference checks A's narrow phase instead of stepping B with it.
+    BasicWorld<GridT> worldA, worldB;
+    worldA.setThreadCount(log.threads);
+    worldB.setThreadCount(opt.threads);
+    BasicReplayPlayer<GridT> a, b;
+    AddKinds(a);
+    AddKinds(b);
+    if (!a.start(log, worldA) || !b.start(log, worldB)) {
+        std::fprintf(stderr, "replay: %s\n", (a.error().empty() ? b.error() : a.error()).c_str());
+        return 2;
+    }
+
+    int64_t  first = -1, worstTick = -1;
+    uint64_t differing = 0;
+    double   worst = 0.0;
+    NarrowCheck narrow;
+    for (;;)
+    {
+        const bool moreA = a.next();
+        const bool moreB = b.next();
+        if (!moreA || !moreB) break;
+
+        const EntityTransforms& ta = worldA.transforms();
+        const EntityTransforms& tb = worldB.transforms();
+        if (ta.size() != tb.size()) {
+            std::fprintf(stderr, "replay: tick %llu: %zu vs %zu entities\n",
+                         (unsigned long long)(worldA.tickIndex() - 1), ta.size(), tb.size());
+            return 2;
+        }
+        double dev = 0.0;
+        for (size_t i = 0; i < ta.size(); ++i)
+            dev = std::max(dev, std::hypot(double(ta.x[i]) - tb.x[i], double(ta.y[i]) - tb.y[i]));
+
+        const int64_t tick = int64_t(worldA.tickIndex() - 1);
+        if (opt.reference) narrow.run(worldA, tick);
+        if (worldA.stateHash() != worldB.stateHash()) {
+            if (differing++ == 0) first = tick;
+            if (differing <= 5) std::fprintf(stderr, "replay: tick %lld differs, max deviation %.6g\n", (long long)tick, dev);
+        }
+        if (dev > worst) { worst = dev; worstTick = tick; }
+    }
+    for (const auto* p : { &a, &b })
+        if (!p->error().empty()) {
+            std::fprintf(stderr, "replay: %s\n", p->error().c_str());
+            return 2;
+        }
+
+    std::printf("{\"log\":\"%s\",\"grid\":\"%s\",\"ticks\":%llu,\"simd\":\"%s\","
+                "\"a\":{\"threads\":%u,\"mismatches\":%llu},"
+                "\"b\":{\"threads\":%u,\"mismatches\":%llu},"
+                "\"first_difference\":%lld,\"ticks_different\":%llu,\"max_deviation\":%.6g,\"max_deviation_tick\":%lld",
+                opt.path.c_str(), GridT::NAME, (unsigned long long)a.ticks(), simd::BackendName(),
+                worldA.threadCount(), (unsigned long long)a.mismatches(),
+                worldB.threadCount(), (unsigned long long)b.mismatches(),
+                (long long)first, (unsigned long long)differing, worst, (long long)worstTick);
+    if (opt.reference)
+        std::printf(",\"reference_sat\":{\"pairs\":%llu,\"hit_mismatches\":%llu,\"max_depth_error\":%.6g,"
+                    "\"axis_ties\":%llu,\"first_mismatch_tick\":%lld}",
+                    (unsigned long long)narrow.pairs, (unsigned long long)narrow.hitMismatches,
+                    narrow.maxDepthError, (unsigned long long)narrow.axisTies, (long long)narrow.firstBad);
+    std::printf("}\n");
+    std::fflush(stdout);
+    return (differing == 0 && narrow.ok()) ? 0 : 1;
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt)
+{
+    if (argc < 3) return false;
+    opt.mode = argv[1];
+    opt.path = argv[2];
+    for (int i = 3; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        auto num = [&](auto& out) { if (!v) return false; out = decltype(out + 0)(std::strtoull(v, nullptr, 10)); ++i; return true; };
+        bool ok = true;
+        if      (!std::strcmp(a, "--ships"))     ok = num(opt.ships);
+        else if (!std::strcmp(a, "--dreads"))    ok = num(opt.dreads);
+        else if (!std::strcmp(a, "--ticks"))     ok = num(opt.ticks);
+        else if (!std::strcmp(a, "--threads"))   ok = num(opt.threads);
+        else if (!std::strcmp(a, "--seed"))      ok = num(opt.seed);
+        else if (!std::strcmp(a, "--grid") && v) { opt.grid = v; ++i; }
+        else if (!std::strcmp(a, "--reference")) opt.reference = true;
+        else ok = false;
+        if (!ok) return false;
+    }
+    return (opt.mode == "record" || opt.mode == "play" || opt.mode == "compare") && opt.ticks > 0 && opt.ships >= 0 && opt.dreads >= 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    Options opt;
+    if (!ParseArgs(argc, argv, opt))
+    {
+        std::fprintf(stderr, "usage: %s record <out.areplay> [--ships N] [--dreads N] [--ticks N] [--seed N]\n"
+                             "                 [--threads N] [--grid uniform|flat|sap]\n"
+                             "       %s play|compare <log.areplay> [--threads N] [--reference]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    if (opt.mode == "record")
+    {
+        if (opt.grid == UniformGrid::NAME)   return Record<UniformGrid>(opt);
+        if (opt.grid == FlatGrid::NAME)      return Record<FlatGrid>(opt);
+        if (opt.grid == SweepAndPrune::NAME) return Record<SweepAndPrune>(opt);
+        std::fprintf(stderr, "replay: unknown grid '%s'\n", opt.grid.c_str());
+        return 2;
+    }
+
+    ReplayLog log;
+    if (!log.load(opt.path)) {
+        std::fprintf(stderr, "replay: cannot read %s\n", opt.path.c_str());
+        return 2;
+    }
+    const bool play = opt.mode == "play";
+    if (log.grid == UniformGrid::NAME)   return play ? Play<UniformGrid>(log, opt)   : Compare<UniformGrid>(log, opt);
+    if (log.grid == FlatGrid::NAME)      return play ? Play<FlatGrid>(log, opt)      : Compare<FlatGrid>(log, opt);
+    if (log.grid == SweepAndPrune::NAME) return play ? Play<SweepAndPrune>(log, opt) : Compare<SweepAndPrune>(log, opt);
+    std::fprintf(stderr, "replay: %s uses an unknown grid '%s'\n", opt.path.c_str(), log.grid.c_str());
+    return 2;
+}
@@ -0,0 +1,109 @@
+/***********************************************************************************
+ *                              [BROAD-PHASE BENCH]
+ * @brief Compares UniformGrid, FlatGrid and SweepAndPrune on the same workload.
+ * @details Spawns N boxes either uniformly over the world or bunched into a few
+ *          fleets, jitters them every frame like wandering ships, and times the
+ *          broad-phase work World::update does per frame: update proxies,
+ *          rebuild, collect pairs.
+ * @details No window, no textures – only the spatial index is exercised.
+ *
+ * Usage:  Aspace_broadphase_bench [entities=2000] [frames=300]
+ ************************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "world.hpp"
+
+namespace {
+
+struct BenchBody : Entity
+{
+    explicit BenchBody(Rectangle box) { overallAABB = box; }
+    Rectangle gridBox{};   // box the index currently holds (World keeps these in EntityTransforms)
+};
+
+enum class Layout { Uniform, Clustered };
+
+std::vector<std::unique_ptr<BenchBody>> MakeBodies(Layout layout, int count, unsigned seed)
+{
+    constexpr float W = World::WORLD_W, H = World::WORLD_H;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> ux(0.f, W), uy(0.f, H), size(48.f, 480.f);
+    std::normal_distribution<float>       spread(0.f, 600.f);
+
+    // clustered: 4 fleet centres, everybody gathers around one of them
+    Vector2 fleets[4] = { {W*0.2f, H*0.3f}, {W*0.7f, H*0.25f}, {W*0.4f, H*0.7f}, {W*0.8f, H*0.8f} };
+
+    std::vector<std::unique_ptr<BenchBody>> out;
+    out.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        Vector2 c = layout == Layout::Uniform
+                  ? Vector2{ ux(rng), uy(rng) }
+                  : Vector2{ fleets[i % 4].x + spread(rng), fleets[i % 4].y + spread(rng) };
+        float s = size(rng);
+        out.emplace_back(std::make_unique<BenchBody>(Rectangle{ c.x - s*0.5f, c.y - s*0.5f, s, s }));
+    }
+    return out;
+}
+
+struct Result { double msPerFrame; size_t pairs; };
+
+template<typename Index>
+Result Run(Layout layout, int count, int frames)
+{
+    auto bodies = MakeBodies(layout, count, 1234u);
+    Index index(World::WORLD_W, World::WORLD_H, World::CELL_SIZE);
+    for (auto& b : bodies) { b->gridBox = b->overallAABB; index.insert(b.get(), b->gridBox); }
+    index.rebuild();
+
+    std::mt19937 rng(99u);
+    std::uniform_real_distribution<float> jitter(-4.f, 4.f);   // ~50-250 px/s at 60 fps
+    std::vector<EntityPair> pairs;
+
+    using clock = std::chrono::steady_clock;
+    clock::duration total{};
+    size_t pairSum = 0;
+    for (int f = 0; f < frames; ++f)
+    {
+        for (auto& b : bodies) { b->overallAABB.x += jitter(rng); b->overallAABB.y += jitter(rng); }
+
+        auto t0 = clock::now();
+        for (auto& b : bodies) { index.update(b.get(), b->gridBox, b->overallAABB); b->gridBox = b->overallAABB; }
+        index.rebuild();
+        index.collectPairs(pairs);
+        total += clock::now() - t0;
+        pairSum += pairs.size();
+    }
+    double ms = std::chrono::duration<double, std::milli>(total).count() / frames;
+    return { ms, pairSum / size_t(frames) };
+}
+
+void Report(const char* name, Layout layout, int count, int frames)
+{
+    Result g = Run<UniformGrid>  (layout, count, frames);
+    Result f = Run<FlatGrid>     (layout, count, frames);
+    Result s = Run<SweepAndPrune>(layout, count, frames);
+    std::printf("%-10s %7d | %-13s %8.3f ms  %-13s %8.3f ms  %-13s %8.3f ms | pairs %zu/%zu/%zu\n",
+                name, count,
+                "UniformGrid", g.msPerFrame, "FlatGrid", f.msPerFrame, "SweepAndPrune", s.msPerFrame,
+                g.pairs, f.pairs, s.pairs);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int count  = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+
+    std::printf("broad-phase per frame (update + rebuild + collectPairs), %d frames\n", frames);
+    Report("uniform",   Layout::Uniform,   count, frames);
+    Report("clustered", Layout::Clustered, count, frames);
+    return 0;
+}
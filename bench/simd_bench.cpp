@@ -0,0 +1,101 @@
+/***********************************************************************************
+ *                                [SIMD KERNEL BENCH]
+ * @brief Micro-benchmark for the kernels in simdkernels.hpp.
+ * @details For several polygon sizes, times TransformPoints and ProjectPoints
+ *          against their *Scalar reference twins and reports the largest
+ *          absolute difference, so a backend that drifts is caught right here.
+ *
+ * Usage:  Aspace_simd_bench [iterations=200000]
+ ************************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "simdkernels.hpp"
+
+namespace {
+
+struct Pt { float x, y; };
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Fn>
+double NsPerCall(int iterations, Fn&& fn)
+{
+    auto t0 = clock_type::now();
+    for (int i = 0; i < iterations; ++i) fn(i);
+    return std::chrono::duration<double, std::nano>(clock_type::now() - t0).count() / iterations;
+}
+
+volatile float g_sink = 0.0f;   // keeps the optimiser honest
+
+void BenchSize(size_t vertices, int iterations)
+{
+    std::mt19937 rng(7u);
+    std::uniform_real_distribution<float> coord(-300.f, 300.f), ang(0.f, 6.2831853f);
+
+    std::vector<Pt> pts(vertices);
+    for (auto& p : pts) p = { coord(rng), coord(rng) };
+
+    simd::SoAVertices local, world, ref;
+    local.assign(pts);
+    world = local;
+    ref   = local;
+    const size_t n = local.padded();
+
+    // --- correctness ------------------------------------------------------
+    float maxErrT = 0.0f, maxErrP = 0.0f;
+    for (int k = 0; k < 256; ++k) {
+        float a = ang(rng), c = std::cos(a), s = std::sin(a), tx = coord(rng), ty = coord(rng);
+        simd::TransformPoints      (local.x.data(), local.y.data(), world.x.data(), world.y.data(), n, c, s, 1.5f, tx, ty);
+        simd::TransformPointsScalar(local.x.data(), local.y.data(), ref.x.data(),   ref.y.data(),   n, c, s, 1.5f, tx, ty);
+        for (size_t i = 0; i < n; ++i)
+            maxErrT = std::max(maxErrT, std::max(std::fabs(world.x[i] - ref.x[i]), std::fabs(world.y[i] - ref.y[i])));
+
+        float mn, mx, rmn, rmx;
+        simd::ProjectPoints      (world.x.data(), world.y.data(), n, c, s, mn, mx);
+        simd::ProjectPointsScalar(world.x.data(), world.y.data(), world.count, c, s, rmn, rmx);
+        maxErrP = std::max(maxErrP, std::max(std::fabs(mn - rmn), std::fabs(mx - rmx)));
+    }
+
+    // --- timing -------------------------------------------------------------
+    double tSimd = NsPerCall(iterations, [&](int i){
+        simd::TransformPoints(local.x.data(), local.y.data(), world.x.data(), world.y.data(), n,
+                              0.8f, 0.6f, 1.0f, float(i & 255), 3.0f);
+        g_sink = g_sink + world.x[0];
+    });
+    double tScalar = NsPerCall(iterations, [&](int i){
+        simd::TransformPointsScalar(local.x.data(), local.y.data(), world.x.data(), world.y.data(), world.count,
+                                    0.8f, 0.6f, 1.0f, float(i & 255), 3.0f);
+        g_sink = g_sink + world.x[0];
+    });
+    double pSimd = NsPerCall(iterations, [&](int i){
+        float mn, mx;
+        simd::ProjectPoints(world.x.data(), world.y.data(), n, 0.8f, 0.6f + (i & 1) * 1e-3f, mn, mx);
+        g_sink = g_sink + mn + mx;
+    });
+    double pScalar = NsPerCall(iterations, [&](int i){
+        float mn, mx;
+        simd::ProjectPointsScalar(world.x.data(), world.y.data(), world.count, 0.8f, 0.6f + (i & 1) * 1e-3f, mn, mx);
+        g_sink = g_sink + mn + mx;
+    });
+
+    std::printf("%4zu verts | transform %7.2f ns (scalar %7.2f)  err %.2e | project %7.2f ns (scalar %7.2f)  err %.2e\n",
+                vertices, tSimd, tScalar, maxErrT, pSimd, pScalar, maxErrP);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    std::printf("SIMD backend: %s, %d iterations per kernel\n", simd::BackendName(), iterations);
+    for (size_t v : { 3u, 7u, 16u, 32u, 128u })
+        BenchSize(v, iterations);
+    return 0;
+}
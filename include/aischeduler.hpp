@@ -0,0 +1,61 @@
+/* ──────────────────────────  aischeduler.hpp  ─────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ aischeduler.hpp — level of detail for entity think() calls.
+//   World asks it, once per tick and entity, whether an AI-LOD entity
+//   (Entity::aiLod) thinks this tick or only coasts:
+//     • near the camera view   → every tick
+//     • off-screen, mid range  → every `midStride` ticks
+//     • beyond that            → every `farStride` ticks
+//   Entities are spread over the ticks by a per-entity phase (their
+//   handle index), so a 16-tick stride costs 1/16 of the fleet per tick
+//   instead of the whole fleet every 16th tick. Read-only during the
+//   parallel update, so workers may query it concurrently.
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+struct AiLodPolicy
+{
+    float    nearMargin = 512.0f;    // world units around the view that still count as near
+    float    midRange   = 4096.0f;   // distance from the view for the mid stride
+    uint32_t midStride  = 4;         // ticks between thinks
+    uint32_t farStride  = 16;
+};
+
+class AiScheduler
+{
+public:
+    void               setPolicy(const AiLodPolicy& p) { lod = p; }
+    const AiLodPolicy& policy() const                  { return lod; }
+
+    // start of a tick: `view` is the camera's world rectangle
+    void beginTick(const Rectangle& view)
+    {
+        ++tick;
+        nearBox = { view.x - lod.nearMargin, view.y - lod.nearMargin,
+                    view.width + lod.nearMargin * 2, view.height + lod.nearMargin * 2 };
+    }
+
+    // ticks between thinks for an entity with these bounds
+    uint32_t strideFor(const Rectangle& box) const
+    {
+        const float dx = std::max({ nearBox.x - (box.x + box.width), box.x - (nearBox.x + nearBox.width), 0.0f });
+        const float dy = std::max({ nearBox.y - (box.y + box.height), box.y - (nearBox.y + nearBox.height), 0.0f });
+        if (dx == 0.0f && dy == 0.0f) return 1;
+        return (dx * dx + dy * dy <= lod.midRange * lod.midRange) ? lod.midStride : lod.farStride;
+    }
+
+    bool due(uint32_t phase, uint32_t stride) const
+    {
+        return stride <= 1 || (tick + phase) % stride == 0;
+    }
+
+private:
+    AiLodPolicy lod;
+    Rectangle   nearBox{};
+    uint64_t    tick = 0;
+};
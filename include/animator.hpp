@@ -2,10 +2,13 @@
 #include <raylib.h>
 #include <vector>
 #include <string>
-#include <functional>
+#include <memory>
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 /* ───────────────────────────── Frame ───────────────────────────── */
 
@@ -18,26 +21,47 @@ struct Frame
     Vector2   GetCenter() const;              // center of the frame in local space
 };
 
-Vector2 Frame::GetCenter() const
+inline Vector2 Frame::GetCenter() const
 {
     return { src.x + src.width / 2.0f, src.y + src.height / 2.0f };
 }
 
-/* ───────────────────────── Animation ───────────────────────────── */
+/* ──────────────────────── AnimationState ──────────────────────── */
 /**
- * @class Animation
- * @brief Manages a sequence of frames for 2D sprite animation with support for different loop modes.
+ * @brief Per-instance playback cursor into an AnimationClip.
  *
- * The Animation class allows you to define and control frame-based animations for sprites.
- * It supports different loop modes (Loop, Once, PingPong), playback speed adjustment, and frame offsets.
- * You can add frames with specific source rectangles, durations, and offsets, and control how the animation
- * progresses and is rendered.
+ * Plain data (16 bytes, trivially copyable): kept in contiguous arrays
+ * and advanced in batches by AdvanceAnimations(). The clip it plays is
+ * stored next to it by the owner, not inside it.
+ */
+struct AnimationState
+{
+    enum Flags : uint32_t { Reverse = 1u << 0, Finished = 1u << 1 };
+
+    int32_t  idx     = 0;      // current frame
+    float    elapsed = 0.0f;   // time into the current frame
+    float    speed   = 1.0f;   // 1.0 = normal, negative = play backwards
+    uint32_t flags   = 0;
+
+    bool finished() const { return (flags & Finished) != 0; }
+};
+static_assert(std::is_trivially_copyable_v<AnimationState>, "AnimationState must stay POD");
+
+/* ───────────────────────── AnimationClip ───────────────────────── */
+/**
+ * @class AnimationClip
+ * @brief Immutable frame sequence + loop mode, shared by every sprite that plays it.
+ *
+ * A clip is authored once (AddFrame(), offset helpers), then wrapped in an
+ * AnimationClipPtr (Share()) and handed to any number of parts. Playback
+ * position lives in an AnimationState per instance, so a fleet of 1000
+ * ships with the same engine flames holds ONE frame list.
  *
  * Usage:
- * - Add frames using AddFrame().
- * - Update the animation state with Update().
- * - Draw the current frame using one of the Draw() methods.
- * - Control playback with Reset(), SetLoopMode(), and SetPlaybackSpeed().
+ * - Add frames using AddFrame(), then Share() the clip.
+ * - Get a fresh cursor with Start(), advance it with Advance() or
+ *   AdvanceAnimations() for a whole array of them.
+ * - Draw the cursor's frame with Draw() or read it with Current().
  *
  * Features:
  * - Supports looping, single-play, and ping-pong playback.
@@ -46,67 +70,88 @@ Vector2 Frame::GetCenter() const
  *
  * Example:
  * @code
- * Animation walk("Walk", Animation::LoopMode::Loop);
+ * AnimationClip walk("Walk", AnimationClip::LoopMode::Loop);
  * walk.AddFrame({0,0,32,32}, 0.1f).AddFrame({32,0,32,32}, 0.1f);
- * walk.Update(deltaTime);
- * walk.Draw(texture, position);
+ * AnimationClipPtr clip = Share(std::move(walk));
+ * AnimationState   st   = clip->Start();
+ * clip->Advance(st, deltaTime);
+ * clip->Draw(st, texture, position);
  * @endcode
  */
-class Animation
+class AnimationClip
 {
 public:
     enum class LoopMode { Loop, Once, PingPong };
 
-    explicit Animation(std::string name,
-                       LoopMode mode          = LoopMode::Loop,
-                       float playbackSpeed    = 1.0f)              // 1.0 = normal speed
+    explicit AnimationClip(std::string name,
+                           LoopMode mode          = LoopMode::Loop,
+                           float playbackSpeed    = 1.0f)              // default for Start()
         : m_name(std::move(name)),
           m_mode(mode),
           m_playbackSpeed(playbackSpeed)
     {}
 
-    /* -- authoring ---------------------------------------------------- */
-    Animation& AddFrame(Rectangle src, float seconds, Vector2 offset = {0, 0})
+    /* -- authoring (before the clip is shared) ------------------------ */
+    AnimationClip& AddFrame(Rectangle src, float seconds, Vector2 offset = {0, 0})
     {
         m_frames.push_back({src, seconds, offset});
         return *this;
     }
 
-    std::string& Name() { return m_name; }
+    void setFramesOffsetToCenter()
+    {
+        for (auto& f : m_frames)
+        {
+            f.offset.x = -f.src.width  / 2.0f;
+            f.offset.y = -f.src.height / 2.0f;
+        }
+    }
+
+    void setFramesOffsetToTopLeft()
+    {
+        for (auto& f : m_frames)
+        {
+            f.offset.x = f.src.x;
+            f.offset.y = f.src.y;
+        }
+    }
 
-    /* -- runtime ------------------------------------------------------ */
-    void Update(float dt)
+    /* -- playback ----------------------------------------------------- */
+    // a cursor at the clip's first frame (last one when played backwards)
+    AnimationState Start(float speed) const
     {
-        if (m_frames.empty() || m_finished) return;
+        AnimationState s;
+        s.speed = speed;
+        s.idx   = (speed >= 0 || m_mode == LoopMode::PingPong) ? 0 : int32_t(m_frames.size()) - 1;
+        if (s.idx < 0) s.idx = 0;
+        return s;
+    }
+    AnimationState Start() const { return Start(m_playbackSpeed); }
 
-        if (m_frames.size() == 1) return;
+    // At most one frame step per call; the time left over carries into the next
+    void Advance(AnimationState& s, float dt) const
+    {
+        if (m_frames.size() <= 1 || s.finished()) return;
 
-        // honour playback speed (can be <0 for reverse)
-        dt *= m_playbackSpeed;
-        m_elapsed += dt;
+        s.elapsed += dt * s.speed;
 
         // allow tiny or even 0‑length frames safely
-        const float frameDur = std::max(m_frames[m_idx].duration,
+        const float frameDur = std::max(m_frames[s.idx].duration,
                                         std::numeric_limits<float>::epsilon());
+        if (std::abs(s.elapsed) < frameDur) return;   // common case: same frame
 
-        // advance while we still have enough accumulated time
-        while (std::abs(m_elapsed) >= frameDur && !m_finished)
-        {
-            m_elapsed = std::fmod(m_elapsed, frameDur);
-
-            // direction step (+1 or -1 in ping‑pong)
-            int step = (m_reverse ? -1 : 1);
-            m_idx += step;
-
-            if (m_idx >= static_cast<int>(m_frames.size()) || m_idx < 0)
-                HandleLoopBoundary();
-        }
+        s.elapsed = std::fmod(s.elapsed, frameDur);
+        s.idx    += (s.flags & AnimationState::Reverse) ? -1 : 1;
+        if (s.idx >= int32_t(m_frames.size()) || s.idx < 0) HandleLoopBoundary(s);
     }
 
+    const Frame& Current(const AnimationState& s) const { return m_frames[s.idx]; }
+
     /* Draw variant 1:
        - position is where *this part* lives in world/parent space
        - optional pivot lets you spin around whatever point you like   */
-    void Draw(Texture2D tex,
+    void Draw(const AnimationState& s,
+              Texture2D tex,
               Vector2   position,
               float     rotation           = 0.0f,
               float     scale              = 1.0f,
@@ -114,7 +159,7 @@ public:
               Color     tint               = WHITE) const
     {
         if (m_frames.empty()) return;
-        const Frame& f = m_frames[m_idx];
+        const Frame& f = m_frames[s.idx];
 
         Rectangle dest = { position.x + f.offset.x,
                            position.y + f.offset.y,
@@ -127,7 +172,8 @@ public:
     /* Draw variant 2:
        - *entityPos*   = absolute position of the owning Entity
        - *partOffset*  = local offset of this attachment on that Entity */
-    void Draw(Texture2D tex,
+    void Draw(const AnimationState& s,
+              Texture2D tex,
               Vector2   entityPos,
               Vector2   partOffset,
               float     rotation           = 0.0f,
@@ -135,64 +181,37 @@ public:
               Vector2   pivot              = {0, 0},
               Color     tint               = WHITE) const
     {
-        Draw(tex, {entityPos.x + partOffset.x,
-                   entityPos.y + partOffset.y},
+        Draw(s, tex, {entityPos.x + partOffset.x,
+                      entityPos.y + partOffset.y},
              rotation, scale, pivot, tint);
     }
 
-    /* ------------- misc getters/setters ----------------------------- */
-    const std::string& Name()        const { return m_name; }
-    const Frame&       Current()     const { return m_frames[m_idx]; }
-    bool               Finished()    const { return m_finished; }
-
-    void  Reset(bool forceToStart = true)
-    {
-        m_idx      = (m_playbackSpeed >= 0 || m_mode == LoopMode::PingPong) ? 0 : static_cast<int>(m_frames.size() - 1);
-        m_elapsed  = 0.0f;
-        m_reverse  = false;
-        m_finished = false;
-        if (!forceToStart && m_idx >= static_cast<int>(m_frames.size())) m_idx = 0;
-    }
-    void  SetLoopMode(LoopMode mode)        { m_mode = mode; }
-    void  SetPlaybackSpeed(float speed)     { m_playbackSpeed = speed; }
-    float PlaybackSpeed()            const  { return m_playbackSpeed; }
-
-    void setFramesOffsetToCenter()
-    {
-        for (auto& f : m_frames)
-        {
-            f.offset.x = -f.src.width  / 2.0f;
-            f.offset.y = -f.src.height / 2.0f;
-        }
-    }
-
-    void setFramesOffsetToTopLeft()
-    {
-        for (auto& f : m_frames)
-        {
-            f.offset.x = f.src.x;
-            f.offset.y = f.src.y;
-        }
-    }
+    /* ------------- getters ------------------------------------------ */
+    const std::string&        Name()          const { return m_name; }
+    const std::vector<Frame>& Frames()        const { return m_frames; }
+    size_t                    FrameCount()    const { return m_frames.size(); }
+    LoopMode                  Mode()          const { return m_mode; }
+    float                     PlaybackSpeed() const { return m_playbackSpeed; }
 
 private:
     /* -- helper: what to do when we run past an end ------------------ */
-    void HandleLoopBoundary()
+    void HandleLoopBoundary(AnimationState& s) const
     {
+        const int32_t last = int32_t(m_frames.size()) - 1;
         switch (m_mode)
         {
         case LoopMode::Loop:
-            m_idx = (m_idx < 0) ? static_cast<int>(m_frames.size() - 1) : 0;
+            s.idx = (s.idx < 0) ? last : 0;
             break;
 
         case LoopMode::Once:
-            m_idx      = (m_idx < 0) ? 0 : static_cast<int>(m_frames.size() - 1);
-            m_finished = true;
+            s.idx    = (s.idx < 0) ? 0 : last;
+            s.flags |= AnimationState::Finished;
             break;
 
         case LoopMode::PingPong:
-            m_reverse  = !m_reverse;
-            m_idx      = std::clamp(m_idx, 0, static_cast<int>(m_frames.size() - 1));
+            s.flags ^= AnimationState::Reverse;
+            s.idx    = std::clamp(s.idx, 0, last);
             break;
         }
     }
@@ -200,12 +219,24 @@ private:
     /* -- data -------------------------------------------------------- */
     std::string        m_name;
     std::vector<Frame> m_frames;
+    LoopMode           m_mode          = LoopMode::Loop;
+    float              m_playbackSpeed = 1.0f;  // negative = play backwards
+};
+
+using AnimationClipPtr = std::shared_ptr<const AnimationClip>;
 
-    /* playback state */
-    int    m_idx           = 0;
-    float  m_elapsed       = 0.0f;
-    bool   m_reverse       = false;
-    bool   m_finished      = false;
-    LoopMode m_mode        = LoopMode::Loop;
-    float     m_playbackSpeed = 1.0f;  // negative = play backwards
-};
\ No newline at end of file
+// freeze an authored clip so it can be shared
+inline AnimationClipPtr Share(AnimationClip clip)
+{
+    return std::make_shared<const AnimationClip>(std::move(clip));
+}
+
+/* ─────────────────────── batched playback ─────────────────────── */
+// Advances states[i] by dt through clips[i]; both arrays are contiguous
+// and parallel. A null clip leaves its state alone (inactive slot).
+inline void AdvanceAnimations(const AnimationClip* const* clips, AnimationState* states,
+                              size_t n, float dt)
+{
+    for (size_t i = 0; i < n; ++i)
+        if (clips[i]) clips[i]->Advance(states[i], dt);
+}
@@ -0,0 +1,419 @@
+/* ──────────────────────────  assetcache.hpp  ──────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ assetcache.hpp — shared, reference-counted textures.
+//   • texture(path, scale, rotation) decodes each distinct
+//     (path, scale, quarter-turns) once and hands out TextureHandles
+//   • handles are cheap to copy; when the last one goes away the GPU
+//     texture is unloaded and the entry forgotten
+//   • stats() reports live textures, GPU bytes, loads vs. cache hits
+//   • textureAsync() returns at once: loader threads decode + resize
+//     the Image, pumpUploads() (main thread, once per frame) turns a
+//     bounded number of them into GPU textures. Until then the handle
+//     yields a small placeholder texture.
+//   Handles must be released on the main thread, and shutdown() called,
+//   before CloseWindow(). A failed load yields an empty texture.
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "profiler.hpp"
+
+class AssetCache;
+
+/* one cached GPU texture */
+struct TextureAsset
+{
+    enum class State { Loading, Ready, Failed };
+
+    std::string        key;
+    std::string        path;
+    float              scale    = 1.0f;
+    int                rotation = 0;       // degrees clockwise, multiple of 90
+    Texture2D          tex{};
+    size_t             bytes    = 0;       // GPU memory (base level)
+    bool               pointFilter = true;
+    const Texture2D*   placeholder = nullptr;  // drawn while Loading
+    std::atomic<State> state{ State::Loading };
+};
+
+/* shared owner of a cached texture ------------------------------------ */
+class TextureHandle
+{
+public:
+    TextureHandle() = default;
+
+    explicit operator bool() const { return asset != nullptr; }
+    bool ready() const { return asset && asset->state.load(std::memory_order_acquire) == TextureAsset::State::Ready; }
+
+    bool loading() const { return asset && asset->state.load(std::memory_order_acquire) == TextureAsset::State::Loading; }
+
+    // the texture to draw with – the placeholder while loading, empty (id 0) if failed
+    const Texture2D& get() const
+    {
+        static const Texture2D empty{};
+        if (ready()) return asset->tex;
+        return (asset && asset->placeholder && loading()) ? *asset->placeholder : empty;
+    }
+    int width()  const { return get().width; }
+    int height() const { return get().height; }
+
+    const std::string& path() const { static const std::string none; return asset ? asset->path : none; }
+    long useCount()          const { return asset.use_count(); }
+
+    bool operator==(const TextureHandle& o) const { return asset == o.asset; }
+    bool operator!=(const TextureHandle& o) const { return asset != o.asset; }
+
+private:
+    friend class AssetCache;
+    explicit TextureHandle(std::shared_ptr<TextureAsset> a) : asset(std::move(a)) {}
+    std::shared_ptr<TextureAsset> asset;
+};
+
+/* the cache ------------------------------------------------------------ */
+class AssetCache
+{
+public:
+    struct Stats {
+        size_t textures = 0;   // alive right now
+        size_t bytes    = 0;   // GPU memory held by them
+        size_t peakBytes= 0;
+        size_t loads    = 0;   // decodes performed
+        size_t hits     = 0;   // requests served from the cache
+        size_t inFlight = 0;   // async loads not uploaded yet
+    };
+
+    static constexpr unsigned LOADER_THREADS  = 2;
+    static constexpr size_t   UPLOADS_PER_FRAME = 2;
+    static constexpr size_t   UPLOAD_BYTES_PER_FRAME = 16u << 20;   // 16 MB
+
+    AssetCache() = default;
+    ~AssetCache()
+    {
+        shutdown();
+        assert(live.empty() && "TextureHandles outlived their AssetCache");
+    }
+
+    AssetCache(const AssetCache&)            = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    /* Load (or share) `path`, resized ⨉scale with nearest-neighbour and
+       turned `rotation` degrees clockwise (rounded to quarter turns).
+       Always decoded on return: a key still loading async is finished
+       here, the loader's copy is dropped when it arrives. */
+    TextureHandle texture(const std::string& path, float scale = 1.0f, int rotation = 0, bool pointFilter = true)
+    {
+        rotation = NormalizeRotation(rotation);
+        const std::string key = MakeKey(path, scale, rotation);
+
+        std::lock_guard<std::mutex> lk(mx);
+        auto it = live.find(key);
+        if (it != live.end())
+            if (auto sp = it->second.lock())
+            {
+                ++counters.hits;
+                if (sp->state.load(std::memory_order_acquire) == TextureAsset::State::Loading)
+                {
+                    Image img = DecodeImage(path, sp->scale, sp->rotation);
+                    ++counters.loads;
+                    upload(*sp, img);
+                }
+                return TextureHandle(std::move(sp));
+            }
+
+        auto sp = makeAsset(key, path, scale, rotation, pointFilter);
+        Image img = DecodeImage(path, scale, rotation);
+        ++counters.loads;
+        upload(*sp, img);
+        return TextureHandle(std::move(sp));
+    }
+
+    /* Same key space as texture(), but never blocks: decoding runs on the
+       loader threads, the GPU upload in pumpUploads(). Main thread only. */
+    TextureHandle textureAsync(const std::string& path, float scale = 1.0f, int rotation = 0, bool pointFilter = true)
+    {
+        rotation = NormalizeRotation(rotation);
+        const std::string key = MakeKey(path, scale, rotation);
+
+        std::shared_ptr<TextureAsset> sp;
+        {
+            std::lock_guard<std::mutex> lk(mx);
+            auto it = live.find(key);
+            if (it != live.end())
+                if (auto hit = it->second.lock()) { ++counters.hits; return TextureHandle(std::move(hit)); }
+
+            sp = makeAsset(key, path, scale, rotation, pointFilter);
+            sp->placeholder = &placeholderTexture();
+            ++counters.loads;
+        }
+        startLoaders();
+        inFlight.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lk(queueMx);
+            decodeQueue.push_back(sp);
+        }
+        queueCv.notify_one();
+        return TextureHandle(std::move(sp));
+    }
+
+    /* Main thread, once per frame: upload decoded images, at most
+       `maxUploads` of them or until `maxBytes` went to the GPU.
+       Returns the number uploaded. */
+    size_t pumpUploads(size_t maxUploads = UPLOADS_PER_FRAME, size_t maxBytes = UPLOAD_BYTES_PER_FRAME)
+    {
+        size_t done = 0, bytes = 0;
+        while (done < maxUploads && bytes < maxBytes)
+        {
+            Decoded d;
+            {
+                std::lock_guard<std::mutex> lk(uploadMx);
+                if (uploadQueue.empty()) break;
+                d = std::move(uploadQueue.front());
+                uploadQueue.pop_front();
+            }
+            if (d.img.data) bytes += size_t(GetPixelDataSize(d.img.width, d.img.height, d.img.format));
+            {
+                std::lock_guard<std::mutex> lk(mx);
+                if (d.asset->state.load(std::memory_order_acquire) == TextureAsset::State::Loading)
+                    upload(*d.asset, d.img);
+                else if (d.img.data)    // texture() got there first
+                    UnloadImage(d.img);
+            }
+            inFlight.fetch_sub(1, std::memory_order_relaxed);
+            ++done;
+        }   // d.asset dropped here – unloads at once if nobody wanted it any more
+        return done;
+    }
+
+    size_t pending() const { return inFlight.load(std::memory_order_relaxed); }
+
+    // block until every async load is uploaded (loading screens, tools)
+    void finishLoading()
+    {
+        while (pending() > 0)
+            if (pumpUploads(size_t(-1), size_t(-1)) == 0) std::this_thread::yield();
+    }
+
+    /* Stop the loader threads and free the placeholder. Call after the
+       last handle is gone and before CloseWindow(). Idempotent. */
+    void shutdown()
+    {
+        stopLoaders();
+        if (placeholder.id) { UnloadTexture(placeholder); placeholder = {}; }
+    }
+
+    Stats stats() const
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        Stats s = counters;
+        s.textures = live.size();
+        s.inFlight = pending();
+        return s;
+    }
+
+    // "12 textures, 34.5 MB" – debug overlay / log helper
+    std::string describe() const
+    {
+        Stats s = stats();
+        char buf[128];
+        std::snprintf(buf, sizeof buf, "%zu textures, %.1f MB (%zu loads, %zu hits, %zu loading)",
+                      s.textures, double(s.bytes) / (1024.0*1024.0), s.loads, s.hits, s.inFlight);
+        return buf;
+    }
+
+    static int NormalizeRotation(int degrees)
+    {
+        int q = ((degrees % 360) + 360) % 360;
+        return ((q + 45) / 90 % 4) * 90;
+    }
+
+    // CPU side: decode + nearest-neighbour resize + quarter turns
+    static Image DecodeImage(const std::string& path, float scale, int rotation)
+    {
+        PROFILE_ZONE("asset: decode");
+        Image img = LoadImage(path.c_str());
+        if (!img.data) return img;
+        if (scale > 0.0f && scale != 1.0f)
+            ImageResizeNN(&img, int(img.width * scale), int(img.height * scale));
+        for (int r = 0; r < rotation; r += 90) ImageRotateCW(&img);
+        return img;
+    }
+
+private:
+    static std::string MakeKey(const std::string& path, float scale, int rotation)
+    {
+        char suffix[48];
+        std::snprintf(suffix, sizeof suffix, "|%g|%d", double(scale), rotation);
+        return path + suffix;
+    }
+
+    struct Decoded {
+        std::shared_ptr<TextureAsset> asset;
+        Image                         img{};
+    };
+
+    // caller holds mx
+    std::shared_ptr<TextureAsset> makeAsset(const std::string& key, const std::string& path,
+                                            float scale, int rotation, bool pointFilter)
+    {
+        auto sp = std::shared_ptr<TextureAsset>(new TextureAsset, [this](TextureAsset* a){ release(a); });
+        sp->key         = key;
+        sp->path        = path;
+        sp->scale       = scale;
+        sp->rotation    = rotation;
+        sp->pointFilter = pointFilter;
+        live[key]       = sp;
+        return sp;
+    }
+
+    // main thread (GPU); the asset points at it while loading
+    const Texture2D& placeholderTexture()
+    {
+        if (!placeholder.id) {
+            Image img = GenImageColor(1, 1, Color{ 255, 0, 255, 96 });
+            placeholder = LoadTextureFromImage(img);
+            UnloadImage(img);
+        }
+        return placeholder;
+    }
+
+    /* loader threads ---------------------------------------------------- */
+    void startLoaders()
+    {
+        std::lock_guard<std::mutex> lk(queueMx);
+        if (!loaders.empty()) return;
+        quitting = false;
+        for (unsigned i = 0; i < LOADER_THREADS; ++i) loaders.emplace_back([this]{ loaderLoop(); });
+    }
+
+    void stopLoaders()
+    {
+        {
+            std::lock_guard<std::mutex> lk(queueMx);
+            quitting = true;
+        }
+        queueCv.notify_all();
+        for (auto& t : loaders) t.join();
+        loaders.clear();
+
+        // drop whatever never made it to the GPU
+        std::deque<std::shared_ptr<TextureAsset>> undecoded;
+        std::deque<Decoded>                       decoded;
+        { std::lock_guard<std::mutex> lk(queueMx);  undecoded.swap(decodeQueue); }
+        { std::lock_guard<std::mutex> lk(uploadMx); decoded.swap(uploadQueue); }
+        for (auto& d : decoded) if (d.img.data) UnloadImage(d.img);
+        inFlight.fetch_sub(undecoded.size() + decoded.size(), std::memory_order_relaxed);
+        for (auto& a : undecoded) a->state.store(TextureAsset::State::Failed, std::memory_order_release);
+        for (auto& d : decoded)   d.asset->state.store(TextureAsset::State::Failed, std::memory_order_release);
+    }
+
+    void loaderLoop()
+    {
+        PROFILE_THREAD("asset loader");
+        for (;;)
+        {
+            std::shared_ptr<TextureAsset> a;
+            {
+                std::unique_lock<std::mutex> lk(queueMx);
+                queueCv.wait(lk, [&]{ return quitting || !decodeQueue.empty(); });
+                if (quitting) return;
+                a = std::move(decodeQueue.front());
+                decodeQueue.pop_front();
+            }
+            if (abandoned(a)) {         // every handle dropped meanwhile → skip
+                inFlight.fetch_sub(1, std::memory_order_relaxed);
+                continue;               // (never uploaded → release() makes no GL call)
+            }
+            // CPU only: no GL calls off the main thread. A key texture() has
+            // finished goes back undecoded – it may hold the last reference
+            // to a GPU texture, and pumpUploads() drops it on the main thread
+            Decoded d{ std::move(a), {} };
+            if (d.asset->state.load(std::memory_order_acquire) == TextureAsset::State::Loading)
+                d.img = DecodeImage(d.asset->path, d.asset->scale, d.asset->rotation);
+
+            std::lock_guard<std::mutex> lk(uploadMx);
+            uploadQueue.push_back(std::move(d));
+        }
+    }
+
+    // Handles are only minted under mx, so with it held a count of 1 stays
+    // 1: forget the entry there and then, before texture() / textureAsync()
+    // can lock() it. Only a still-Loading asset qualifies – it owns no GPU
+    // texture, so dropping it here is safe off the main thread.
+    bool abandoned(const std::shared_ptr<TextureAsset>& a)
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        if (a->state.load(std::memory_order_acquire) != TextureAsset::State::Loading) return false;
+        if (a.use_count() != 1) return false;
+        auto it = live.find(a->key);
+        if (it != live.end() && !it->second.owner_before(a) && !a.owner_before(it->second)) live.erase(it);
+        return true;
+    }
+
+    // GPU side: main thread only, caller holds mx; consumes `img`
+    void upload(TextureAsset& a, Image& img)
+    {
+        PROFILE_ZONE("asset: upload");
+        if (!img.data) {
+            TraceLog(LOG_WARNING, "ASSETS: could not load %s", a.path.c_str());
+            a.state.store(TextureAsset::State::Failed, std::memory_order_release);
+            return;
+        }
+        a.tex = LoadTextureFromImage(img);
+        UnloadImage(img);
+        img = Image{};
+        if (a.pointFilter) SetTextureFilter(a.tex, TEXTURE_FILTER_POINT);
+
+        a.bytes = size_t(GetPixelDataSize(a.tex.width, a.tex.height, a.tex.format));
+        counters.bytes    += a.bytes;
+        counters.peakBytes = std::max(counters.peakBytes, counters.bytes);
+        a.state.store(TextureAsset::State::Ready, std::memory_order_release);
+    }
+
+    // last handle gone
+    void release(TextureAsset* a)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mx);
+            auto it = live.find(a->key);
+            if (it != live.end() && it->second.expired()) live.erase(it);
+            counters.bytes -= a->bytes;
+        }
+        if (a->tex.id) UnloadTexture(a->tex);
+        delete a;
+    }
+
+    mutable std::mutex                                   mx;        // live + counters
+    std::unordered_map<std::string, std::weak_ptr<TextureAsset>> live;
+    Stats                                                counters;
+    Texture2D                                            placeholder{};
+
+    std::mutex                                           queueMx;   // decodeQueue + loaders
+    std::condition_variable                              queueCv;
+    std::deque<std::shared_ptr<TextureAsset>>            decodeQueue;
+    std::vector<std::thread>                             loaders;
+    bool                                                 quitting = false;
+
+    std::mutex                                           uploadMx;  // uploadQueue
+    std::deque<Decoded>                                  uploadQueue;
+    std::atomic<size_t>                                  inFlight{0};
+};
+
+/* process-wide default cache (entities that load by path use this one) */
+inline AssetCache& Assets()
+{
+    static AssetCache cache;
+    return cache;
+}
@@ -0,0 +1,217 @@
+/* ───────────────────────────  background.hpp  ─────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ background.hpp — tiled, streamed, parallax background layers.
+//   • a layer is a grid of tile images ("{x}" / "{y}" in the path are
+//     the tile column / row), drawn once from its origin or repeated
+//     endlessly; a single image is just a 1×1 layer
+//   • only tiles under the camera view are drawn; tiles one ring
+//     beyond it are requested through Assets().textureAsync() ahead of
+//     time, tiles more than KEEP_RING away are released again – VRAM
+//     follows the camera instead of holding the whole world
+//   • parallax: 1 = fixed to the world, 0 = fixed to the screen
+//   • layers go into the frame's RenderQueue below every entity (in the
+//     order they were added, farthest first), so background and ships
+//     share one sorted draw stream
+//   Main thread only (texture handles); update() once per drawn frame.
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "assetcache.hpp"
+#include "renderqueue.hpp"
+
+struct BackgroundLayerDesc
+{
+    std::string path;                // tile image, "{x}" / "{y}" → column / row
+    int         cols     = 1;        // tiles in the art
+    int         rows     = 1;
+    bool        repeat   = false;    // wrap the art endlessly instead of drawing it once
+    Vector2     tileSize { 0, 0 };   // world units per tile; 0 = tile (0,0)'s size once loaded
+    Rectangle   src      {};         // region of every tile image to draw (empty = all of it)
+    Vector2     origin   { 0, 0 };   // layer position of tile (0,0)'s top-left corner
+    float       parallax = 1.0f;
+    float       scale    = 1.0f;     // decode scale, as AssetCache::textureAsync
+    Color       tint     = WHITE;
+};
+
+class TiledBackground
+{
+public:
+    static constexpr int FIRST_LAYER   = -30000;  // RenderQueue layer of the farthest layer
+    static constexpr int PREFETCH_RING = 1;       // tiles requested beyond the view
+    static constexpr int KEEP_RING     = 2;       // tiles kept resident beyond the view
+
+    struct Stats {
+        size_t layers   = 0;
+        size_t resident = 0;   // tile handles held (loaded or loading)
+        size_t loading  = 0;
+        size_t drawn    = 0;   // quads submitted by the last submit()
+    };
+
+    size_t addLayer(BackgroundLayerDesc desc)
+    {
+        Layer l;
+        l.desc = std::move(desc);
+        l.desc.cols = std::max(l.desc.cols, 1);
+        l.desc.rows = std::max(l.desc.rows, 1);
+        layers.push_back(std::move(l));
+        return layers.size() - 1;
+    }
+    const BackgroundLayerDesc& layer(size_t i) const { return layers[i].desc; }
+    size_t layerCount() const { return layers.size(); }
+    void   clear()            { layers.clear(); }
+
+    /* per frame: `view` = world rectangle on screen, `cameraTarget` = its
+       parallax reference (the camera target) */
+    void update(const Rectangle& view, Vector2 cameraTarget)
+    {
+        ++frame;
+        for (Layer& l : layers) updateLayer(l, view, cameraTarget);
+    }
+
+    // quads for the tiles in view that are on the GPU (nothing while loading)
+    void submit(RenderQueue& q) const
+    {
+        drawn = 0;
+        for (size_t li = 0; li < layers.size(); ++li)
+        {
+            const Layer& l = layers[li];
+            if (!l.visible.valid()) continue;
+            const int layerId = FIRST_LAYER + int(li);
+
+            for (int ty = l.visible.y0; ty <= l.visible.y1; ++ty)
+                for (int tx = l.visible.x0; tx <= l.visible.x1; ++tx)
+                {
+                    auto it = l.tiles.find(key(wrapX(l, tx), wrapY(l, ty)));
+                    if (it == l.tiles.end() || !it->second.tex.ready()) continue;
+
+                    const Texture2D& tex = it->second.tex.get();
+                    const Rectangle  src = sourceRect(l.desc, tex);
+                    const Rectangle  dst { l.desc.origin.x + tx * l.tileSize.x + l.shift.x,
+                                           l.desc.origin.y + ty * l.tileSize.y + l.shift.y,
+                                           l.tileSize.x, l.tileSize.y };
+                    q.push(tex, src, dst, { 0, 0 }, 0.0f, layerId, l.desc.tint);
+                    ++drawn;
+                }
+        }
+    }
+
+    Stats stats() const
+    {
+        Stats s;
+        s.layers = layers.size();
+        s.drawn  = drawn;
+        for (const Layer& l : layers)
+            for (const auto& [k, t] : l.tiles) { ++s.resident; if (t.tex.loading()) ++s.loading; }
+        return s;
+    }
+
+private:
+    struct Range {
+        int x0 = 0, y0 = 0, x1 = -1, y1 = -1;    // inclusive tile indices
+        bool valid() const { return x0 <= x1 && y0 <= y1; }
+    };
+    struct Tile  { TextureHandle tex; uint64_t seen = 0; };
+    struct Layer {
+        BackgroundLayerDesc                desc;
+        std::unordered_map<uint64_t, Tile> tiles;       // by art tile (wrapped index)
+        Vector2                            tileSize{ 0, 0 };
+        Vector2                            shift{ 0, 0 };   // layer → world offset this frame
+        Range                              visible;
+    };
+
+    static uint64_t key(int x, int y) { return (uint64_t(uint32_t(x)) << 32) | uint32_t(y); }
+
+    static int wrap(int i, int n) { int m = i % n; return m < 0 ? m + n : m; }
+    static int wrapX(const Layer& l, int x) { return l.desc.repeat ? wrap(x, l.desc.cols) : x; }
+    static int wrapY(const Layer& l, int y) { return l.desc.repeat ? wrap(y, l.desc.rows) : y; }
+
+    static Rectangle sourceRect(const BackgroundLayerDesc& d, const Texture2D& tex)
+    {
+        if (d.src.width > 0 && d.src.height > 0) return d.src;
+        return { 0, 0, (float)tex.width, (float)tex.height };
+    }
+
+    static std::string tilePath(const std::string& pattern, int x, int y)
+    {
+        std::string p = pattern;
+        auto subst = [&p](const char* tag, int v) {
+            for (size_t at = p.find(tag); at != std::string::npos; at = p.find(tag, at))
+                p.replace(at, 3, std::to_string(v));
+        };
+        subst("{x}", x);
+        subst("{y}", y);
+        return p;
+    }
+
+    // tile indices covering `r` (layer space), clamped unless repeating
+    static Range tilesOver(const Layer& l, const Rectangle& r, int ring)
+    {
+        Range t;
+        t.x0 = int(std::floor((r.x - l.desc.origin.x) / l.tileSize.x)) - ring;
+        t.y0 = int(std::floor((r.y - l.desc.origin.y) / l.tileSize.y)) - ring;
+        t.x1 = int(std::floor((r.x + r.width  - l.desc.origin.x) / l.tileSize.x)) + ring;
+        t.y1 = int(std::floor((r.y + r.height - l.desc.origin.y) / l.tileSize.y)) + ring;
+        if (!l.desc.repeat) {
+            t.x0 = std::max(t.x0, 0); t.x1 = std::min(t.x1, l.desc.cols - 1);
+            t.y0 = std::max(t.y0, 0); t.y1 = std::min(t.y1, l.desc.rows - 1);
+        }
+        return t;
+    }
+
+    Tile& request(Layer& l, int ax, int ay)
+    {
+        Tile& t = l.tiles[key(ax, ay)];
+        if (!t.tex) t.tex = Assets().textureAsync(tilePath(l.desc.path, ax, ay), l.desc.scale);
+        return t;
+    }
+
+    void updateLayer(Layer& l, const Rectangle& view, Vector2 target)
+    {
+        l.visible = {};
+
+        // tile size: given, or taken from the first tile once it is loaded
+        l.tileSize = l.desc.tileSize;
+        if (l.tileSize.x <= 0 || l.tileSize.y <= 0)
+        {
+            Tile& first = request(l, 0, 0);
+            first.seen = frame;
+            if (!first.tex.ready()) return;
+            const Rectangle s = sourceRect(l.desc, first.tex.get());
+            if (s.width <= 0 || s.height <= 0) return;   // failed load
+            l.tileSize = { s.width, s.height };
+        }
+
+        // the layer scrolls `parallax` times as fast as the world
+        l.shift = { target.x * (1.0f - l.desc.parallax), target.y * (1.0f - l.desc.parallax) };
+        const Rectangle local { view.x - l.shift.x, view.y - l.shift.y, view.width, view.height };
+
+        l.visible = tilesOver(l, local, 0);
+
+        const Range want = tilesOver(l, local, PREFETCH_RING);
+        for (int ty = want.y0; ty <= want.y1; ++ty)
+            for (int tx = want.x0; tx <= want.x1; ++tx)
+                request(l, wrapX(l, tx), wrapY(l, ty)).seen = frame;
+
+        // stream out what drifted beyond the keep ring
+        const Range keep = tilesOver(l, local, KEEP_RING);
+        for (int ty = keep.y0; ty <= keep.y1; ++ty)
+            for (int tx = keep.x0; tx <= keep.x1; ++tx)
+            {
+                auto it = l.tiles.find(key(wrapX(l, tx), wrapY(l, ty)));
+                if (it != l.tiles.end()) it->second.seen = frame;
+            }
+        for (auto it = l.tiles.begin(); it != l.tiles.end(); )
+            it = (it->second.seen == frame) ? std::next(it) : l.tiles.erase(it);
+    }
+
+    std::vector<Layer> layers;
+    uint64_t           frame = 0;
+    mutable size_t     drawn = 0;
+};
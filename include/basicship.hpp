@@ -1,7 +1,9 @@
 /*────────────────────────── basicShip.hpp ──────────────────────────*/
 #pragma once
 #include "entity.hpp"
-#include "spritePart.hpp"
+#include "spritepartset.hpp"
+#include "textureatlas.hpp"
+#include "replay.hpp"
 #include <vector>
 #include <cmath>
 
@@ -11,61 +13,80 @@ class BasicShip : public Entity
 {
 public:
     /*  ▸ share‑texture ctor (recommended) */
-    BasicShip(Texture2D& sharedTex, Vector2 pos)
-        : extTexture(&sharedTex)
+    BasicShip(const Texture2D& sharedTex, Vector2 pos)
+        : BasicShip(AtlasSprite{ &sharedTex, { 0, 0, (float)sharedTex.width, (float)sharedTex.height } }, pos)
+    {}
+
+    /*  ▸ cached texture: the ship holds a share of it */
+    BasicShip(TextureHandle tex, Vector2 pos)
+        : BasicShip(tex.get(), pos)
+    {
+        textureRef = std::move(tex);
+    }
+
+    /*  ▸ atlas ctor: the hull is a region of a shared atlas page */
+    BasicShip(const AtlasSprite& hull, Vector2 pos)
     {
-        texture   = sharedTex;
-        size      = {(float)texture.width, (float)texture.height};
+        texture    = *hull.texture;
+        textureSrc = hull.src;
+        size       = { hull.src.width, hull.src.height };
         position  = pos;
         offset    = {size.x*0.5f, size.y*0.5f};
         speed     = 100.f;
 
         // ─── give the shape a simple equilateral triangle around the pivot ───
-        float h = size.y*0.25f;
-        float w = size.x*0.25f;
-        // local coords relative to the ship's centre:
-        shape.addPolygon({
-            {  0.0f, -h },     // top
-            {  w,    h  },     // bottom right
-            { -w,    h  }      // bottom left
-        });
+        hullDef = HullTriangle(size);
+        setShape(hullDef);
 
         // prep the AABB, etc.
-        shape.updateWorldVertices(position, rotation, /*scale=*/1.0f);
         recalcOverallAABB();
 
     }
 
-    /*  self‑loading ctor (optional) */
+    /*  self‑loading ctor (optional) – goes through Assets() */
     explicit BasicShip(const std::string& path, Vector2 pos = {0,0})
-    {
-        setTexture(path);
-        position = pos;
-        ownsTexture = true;
-    }
+        : BasicShip(Assets().texture(path), pos)
+    {}
 
     /* -------- sprites / parts ------------------------------------ */
+    // returns the part's id (insertion order) for parts[id]
     template<typename... Args>
-    void addPart(Texture2D* tex, Vector2 local, int z, Args&&...animArgs)
+    SpritePartSet::PartId addPart(const Texture2D* tex, Vector2 local, int z, Args&&...animArgs)
     {
-        parts.emplace_back(SpritePart{ tex, Animation{std::forward<Args>(animArgs)...},
-                                       local, z });
+        return parts.add(SpritePart{ tex, std::make_shared<const AnimationClip>(std::forward<Args>(animArgs)...),
+                                     local, z });
     }
-    void addPart(Texture2D* tex, const Animation& anim,
-                 Vector2 local, int z = 0)
+    SpritePartSet::PartId addPart(const Texture2D* tex, AnimationClipPtr clip,
+                                  Vector2 local, int z = 0)
     {
-        parts.emplace_back(SpritePart{ tex, anim, local, z });
+        return parts.add(SpritePart{ tex, std::move(clip), local, z });
     }
 
     /* -------- simple movement API -------------------------------- */
     void setTarget(Vector2 world) { target = world; }
+    // the player ship: head for InputState::mouseWorld every tick
+    void setMouseSteering(bool on) { mouseSteer = on; }
 
-    /* -------- core update / draw --------------------------------- */
-    void update(float dt, const Camera2D&) override
+    /* -------- replay --------------------------------------------- */
+    static constexpr const char* REPLAY_KIND = "BasicShip";
+    const char* replayKind() const override { return REPLAY_KIND; }
+    void saveReplay(ReplayWriter& out) const override { out.vec2(target); out.u8(mouseSteer); }
+    void loadReplay(ReplayReader& in) override        { target = in.vec2(); mouseSteer = in.u8() != 0; }
+
+    // an async hull landed: the default triangle was sized for the placeholder
+    void onTextureFitted() override
     {
+        if (shapeDefinition() != hullDef) return;    // custom outline – leave it
+        hullDef = HullTriangle(size);
+        setShape(hullDef);
+    }
 
-        bool boosting = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+    /* -------- core update / draw --------------------------------- */
+    void update(float dt, const InputState& input) override
+    {
 
+        bool boosting = input.mouseLeft;
+        if (mouseSteer) target = input.mouseWorld;
 
         Vector2 d = { target.x-position.x, target.y-position.y };
         float   L = sqrtf(d.x*d.x + d.y*d.y);
@@ -78,43 +99,44 @@ public:
             rotation = atan2f(d.y,d.x) * RAD2DEG + 90.f;
         }
 
-        parts[0].active = !boosting; 
-        parts[1].active = boosting;
+        if (parts.size() >= 2) {    // idle / powering flames, when fitted
+            parts.setActive(0, !boosting);
+            parts.setActive(1, boosting);
+        }
 
-        for (auto& p: parts) p.update(dt);
-        shape.updateWorldVertices(position, rotation);
-        recalcOverallAABB();
+        parts.update(dt);
+        recalcOverallAABB();        // no-op if the ship did not move
     }
 
-    void draw(const Camera2D&) const override
+    // parts carry their own layer – the queue does the z-sorting
+    void submit(RenderQueue& q) const override
     {
-        std::vector<const SpritePart*> sorted(parts.size());
-        std::transform(parts.begin(),parts.end(),sorted.begin(),
-                       [](const SpritePart& p){ return &p; });
-        std::sort(sorted.begin(),sorted.end(),
-                  [](auto*a,auto*b){ return a->z < b->z; });
-
-        Vector2 pivotWorld = { position.x + offset.x, position.y + offset.y };
-        for (auto* p:sorted) if (p->z<0) p->draw(pivotWorld,rotation);
-
-        Rectangle src{0,0,size.x,size.y};
-        Rectangle dst{position.x,position.y,size.x,size.y};
-        DrawRectangleLinesEx(getOverallAABB(), 2.0f, BLUE);
-        shape.drawLines(RED);
-        DrawTexturePro(texture,src,dst,offset,rotation,WHITE);
-
-        for (auto* p:sorted) if (p->z>=0) p->draw(pivotWorld,rotation);
+        const Vector2 pos = renderPosition();
+        const float   rot = renderRotation();
+        Vector2 pivotWorld = { pos.x + offset.x, pos.y + offset.y };
+        parts.submit(q, pivotWorld, rot);
+
+        Entity::submit(q);   // hull
     }
 
-    ~BasicShip() override
+private:
+    // local coords relative to the ship's centre
+    static ShapeDefPtr HullTriangle(Vector2 size)
     {
-        if (!ownsTexture) texture.id = 0;   // avoid double‑unload
+        const float h = size.y*0.25f;
+        const float w = size.x*0.25f;
+        CollisionShape tri;
+        tri.addPolygon({
+            {  0.0f, -h },     // top
+            {  w,    h  },     // bottom right
+            { -w,    h  }      // bottom left
+        });
+        return ShapeDef::FromShape(tri);
     }
 
-private:
     /* state */
-    std::vector<SpritePart> parts;
+    SpritePartSet parts;
+    ShapeDefPtr   hullDef;     // the default triangle, while it is in use
     Vector2 target = position;
-    bool    ownsTexture = false;
-    Texture2D* extTexture = nullptr;
+    bool    mouseSteer = false;
 };
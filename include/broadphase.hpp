@@ -0,0 +1,201 @@
+/* ─────────────────────────  broadphase.hpp  ───────────────────────── */
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include <entity.hpp>
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   Broad-phase output – one entry per potentially touching pair
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+struct EntityPair { Entity* a; Entity* b; };
+
+inline bool AABBOverlap(const Rectangle& a, const Rectangle& b)
+{
+    return a.x < b.x + b.width  && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// squared distance from `p` to the closest point of `box` (0 inside)
+inline float DistanceSqToAABB(Vector2 p, const Rectangle& box)
+{
+    const float dx = std::max({ box.x - p.x, 0.0f, p.x - (box.x + box.width)  });
+    const float dy = std::max({ box.y - p.y, 0.0f, p.y - (box.y + box.height) });
+    return dx * dx + dy * dy;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   Spatial query results (BasicWorld::raycast / queryRadius / nearest)
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+struct RayHit
+{
+    Entity* entity   = nullptr;
+    float   distance = 0.0f;      // along the (normalised) ray
+    Vector2 point  { 0, 0 };
+    Vector2 normal { 0, 0 };      // outward normal of the edge that was hit
+    explicit operator bool() const { return entity != nullptr; }
+};
+
+struct Neighbour
+{
+    Entity* entity = nullptr;
+    float   distSq = 0.0f;        // to the entity's AABB, 0 if inside it
+};
+
+// default filter: every live entity
+struct AnyEntity { bool operator()(const Entity&) const { return true; } };
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   SweepAndPrune  – persistent sort-and-sweep on the x axis
+   • keeps one interval per entity, sorted by min-x, between frames
+   • rebuild() re-sorts with insertion sort: ships barely move per frame
+     so the list is almost sorted and this is close to O(n)
+   • cost does not depend on how densely entities bunch up in space,
+     unlike the grids which degrade to O(n²) inside a crowded cell
+   Same interface as UniformGrid / FlatGrid, so BasicWorld can take it
+   as its GridT. Uses Entity::gridProxy to find an entity's interval.
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class SweepAndPrune {
+public:
+    static constexpr const char* NAME = "sap";
+
+    // signature matches the grids; the cell size only frames queryCell()
+    SweepAndPrune(int /*worldW*/ = 0, int /*worldH*/ = 0, int cellSz = 512)
+        : cs(float(cellSz > 0 ? cellSz : 512)) {}
+
+    void insert(Entity* e, const Rectangle& box)
+    {
+        e->gridProxy = int(items.size());
+        items.push_back(makeItem(e, box));
+        ++unsorted;
+        sorted = false;
+    }
+
+    // lazy: the slot is only dropped on the next rebuild()
+    void remove(Entity* e, const Rectangle& /*box*/)
+    {
+        int i = e->gridProxy;
+        if (i < 0 || i >= int(items.size()) || items[i].e != e) return;
+        items[i].e   = nullptr;
+        e->gridProxy = -1;
+        ++dead;
+    }
+
+    void update(Entity* e, const Rectangle& /*oldBox*/, const Rectangle& newBox)
+    {
+        int i = e->gridProxy;
+        if (i < 0 || i >= int(items.size()) || items[i].e != e) { insert(e, newBox); return; }
+        items[i] = makeItem(e, newBox);
+        // still in order and no wider than the widest → queries stay exact
+        if (sorted && !inPlace(size_t(i))) sorted = false;
+    }
+
+    void rebuild()
+    {
+        if (dead) {
+            items.erase(std::remove_if(items.begin(), items.end(),
+                                       [](const Item& it){ return it.e == nullptr; }),
+                        items.end());
+            dead = 0;
+        }
+
+        // a burst of spawns is far from sorted – don't pay O(n²) for it
+        if (unsorted > 32 && unsorted * 8 > items.size())
+            std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+                // ties by handle: same order from every standard library
+                return a.minX != b.minX ? a.minX < b.minX : a.e->handle().index < b.e->handle().index;
+            });
+        else
+            insertionSort();
+        unsorted = 0;
+        sorted   = true;
+
+        maxWidth = 0.0f;
+        for (size_t i = 0; i < items.size(); ++i) {
+            items[i].e->gridProxy = int(i);
+            maxWidth = std::max(maxWidth, items[i].maxX - items[i].minX);
+        }
+    }
+
+    // between an out-of-order update() / insert() and the next rebuild()
+    // the search bounds don't hold: scan every interval instead
+    template<typename Fn>
+    void query(const Rectangle& area, Fn&& fn) const
+    {
+        // nothing that starts left of (area.x - widest interval) can reach it
+        size_t i = sorted ? lowerBound(area.x - maxWidth) : 0;
+        const float right = area.x + area.width;
+        for (; i < items.size() && (!sorted || items[i].minX < right); ++i) {
+            const Item& it = items[i];
+            if (it.minX >= right) continue;
+            if (!it.e || it.maxX <= area.x) continue;
+            if (it.maxY <= area.y || it.minY >= area.y + area.height) continue;
+            fn(*it.e);
+        }
+    }
+
+    // everything overlapping cell (cx, cy) of a virtual cs × cs grid, so
+    // the World's cell walks (ray / ring queries) work unchanged
+    template<typename Fn>
+    void queryCell(int cx, int cy, Fn&& fn) const { query({ cx * cs, cy * cs, cs, cs }, fn); }
+
+    // every overlapping pair once, in sweep order (deterministic)
+    void collectPairs(std::vector<EntityPair>& out) const
+    {
+        out.clear();
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            const Item& a = items[i];
+            if (!a.e) continue;
+            for (size_t j = i + 1; j < items.size() && items[j].minX < a.maxX; ++j)
+            {
+                const Item& b = items[j];
+                if (!b.e || b.maxY <= a.minY || b.minY >= a.maxY) continue;
+                out.push_back({ a.e, b.e });
+            }
+        }
+    }
+
+private:
+    struct Item { float minX, maxX, minY, maxY; Entity* e; };
+
+    std::vector<Item> items;          // sorted by minX after rebuild()
+    size_t            unsorted = 0;   // inserts since the last rebuild
+    size_t            dead     = 0;   // removed, not yet compacted
+    float             maxWidth = 0.0f;
+    bool              sorted   = true; // items ordered, maxWidth current
+    float             cs;             // queryCell() only
+
+    static Item makeItem(Entity* e, const Rectangle& b)
+    {
+        return { b.x, b.x + b.width, b.y, b.y + b.height, e };
+    }
+
+    bool inPlace(size_t i) const
+    {
+        const Item& it = items[i];
+        return it.maxX - it.minX <= maxWidth &&
+               (i == 0                || !(it.minX < items[i-1].minX)) &&
+               (i + 1 == items.size() || !(items[i+1].minX < it.minX));
+    }
+
+    void insertionSort()
+    {
+        for (size_t i = 1; i < items.size(); ++i) {
+            if (!(items[i].minX < items[i-1].minX)) continue;
+            Item   key = items[i];
+            size_t j   = i;
+            while (j > 0 && key.minX < items[j-1].minX) { items[j] = items[j-1]; --j; }
+            items[j] = key;
+        }
+    }
+
+    size_t lowerBound(float x) const
+    {
+        return size_t(std::lower_bound(items.begin(), items.end(), x,
+                       [](const Item& it, float v){ return it.minX < v; }) - items.begin());
+    }
+};
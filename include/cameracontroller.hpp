@@ -0,0 +1,107 @@
+/* ────────────────────────  cameracontroller.hpp  ──────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ cameracontroller.hpp — the World's 2D camera, once per rendered
+//   frame (never per simulation tick):
+//     • ctrl + wheel sets a target zoom; the real zoom eases towards
+//       it at the same speed whatever the frame rate
+//     • the target is clamped so the view stays inside the world at
+//       the CURRENT zoom (centred when the world is smaller than it)
+//     • view() is the world rectangle on screen, computed once in
+//       update() – culling, background and AI LOD all reuse it
+//   Uses the screen size from the input snapshot, not raylib, so it
+//   runs headless as well.
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include "inputstate.hpp"
+
+class CameraController
+{
+public:
+    static constexpr float MIN_ZOOM   = 0.5f;
+    static constexpr float MAX_ZOOM   = 3.0f;
+    static constexpr float ZOOM_STEP  = 0.2f;    // per wheel notch
+    static constexpr float ZOOM_SPEED = 8.0f;    // 1/s, the larger the snappier
+
+    CameraController(Vector2 worldSize, Vector2 screen)
+        : world(worldSize)
+    {
+        cam.rotation = 0.0f;
+        cam.zoom     = 1.0f;
+        cam.target   = { world.x * 0.5f, world.y * 0.5f };
+        refresh(screen);
+    }
+
+    /* input -------------------------------------------------------------- */
+    void handleInput(const InputState& input)
+    {
+        if (!input.ctrl || input.wheel == 0.0f) return;
+        setTargetZoom(targetZoom + (input.wheel > 0 ? ZOOM_STEP : -ZOOM_STEP));
+    }
+    void  setTargetZoom(float z)   { targetZoom = std::clamp(z, minZoom, maxZoom); }
+    float getTargetZoom() const    { return targetZoom; }
+    void  setZoomLimits(float lo, float hi)
+    {
+        minZoom = std::max(lo, 0.01f);
+        maxZoom = std::max(hi, minZoom);
+        setTargetZoom(targetZoom);
+    }
+    // jump straight to the target zoom (e.g. after a level load)
+    void  snapZoom()               { cam.zoom = targetZoom; }
+
+    /* per frame ---------------------------------------------------------- */
+    // `focus` = what to look at this frame (the followed entity's render pose)
+    void update(float frameDt, Vector2 focus, Vector2 screen)
+    {
+        cam.target = focus;
+        update(frameDt, screen);
+    }
+    void update(float frameDt, Vector2 screen)
+    {
+        // exponential ease: same curve at 30 or 240 FPS
+        const float k = 1.0f - std::exp(-zoomSpeed * std::max(frameDt, 0.0f));
+        cam.zoom += (targetZoom - cam.zoom) * k;
+        if (std::fabs(targetZoom - cam.zoom) < 1e-4f) cam.zoom = targetZoom;
+
+        refresh(screen);
+    }
+
+    /* results ------------------------------------------------------------ */
+    const Camera2D& camera() const { return cam; }
+    float           zoom()   const { return cam.zoom; }
+    // world rectangle on screen as of the last update()
+    const Rectangle& view() const  { return viewRect; }
+    // same, `marginPx` screen pixels wider on every side
+    Rectangle view(float marginPx) const
+    {
+        const float m = marginPx / cam.zoom;
+        return { viewRect.x - m, viewRect.y - m, viewRect.width + 2 * m, viewRect.height + 2 * m };
+    }
+
+    void setZoomSpeed(float perSecond) { zoomSpeed = std::max(perSecond, 0.0f); }
+
+private:
+    // offset, clamp and view for the current zoom / target
+    void refresh(Vector2 screen)
+    {
+        cam.offset = { screen.x * 0.5f, screen.y * 0.5f };
+
+        const float halfW = screen.x * 0.5f / cam.zoom;
+        const float halfH = screen.y * 0.5f / cam.zoom;
+        cam.target.x = (halfW * 2 >= world.x) ? world.x * 0.5f : std::clamp(cam.target.x, halfW, world.x - halfW);
+        cam.target.y = (halfH * 2 >= world.y) ? world.y * 0.5f : std::clamp(cam.target.y, halfH, world.y - halfH);
+
+        viewRect = { cam.target.x - halfW, cam.target.y - halfH, halfW * 2, halfH * 2 };
+    }
+
+    Camera2D  cam{};
+    Vector2   world;
+    Rectangle viewRect{};
+    float     targetZoom = 1.0f;
+    float     minZoom    = MIN_ZOOM;
+    float     maxZoom    = MAX_ZOOM;
+    float     zoomSpeed  = ZOOM_SPEED;
+};
@@ -34,13 +34,31 @@
 
 #pragma once
 #include <raylib.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <functional> 
+#include "simdkernels.hpp"
 
 // Forward declaration
 class Entity;
 
+// Read-only world-space view of one convex piece, wherever it is stored
+// (a ConvexPolygon, or an instance in a ShapePool). The SAT code only
+// works on views. `x`/`y` are padded SoA arrays (may be null), `aos` the
+// plain vertex array (may be null); at least one of them is set.
+struct PolygonView {
+    const float*   x = nullptr;
+    const float*   y = nullptr;
+    size_t         padded = 0;       // length of x / y
+    const Vector2* aos = nullptr;
+    size_t         count = 0;        // real vertices
+    const Vector2* normals = nullptr;
+    size_t         normalCount = 0;
+    Vector2        center{0, 0};
+    Rectangle      aabb{};
+};
+
 // Represents a single convex polygon
 struct ConvexPolygon {
     // Vertices are stored local to the entity's chosen pivot point.
@@ -48,18 +66,39 @@ struct ConvexPolygon {
     // for PhysicsEditor's AnchorPoint).
     std::vector<Vector2> localVertices;
     std::vector<Vector2> worldVertices; // Transformed vertices in world space
+    std::vector<Vector2> localNormals;  // Unique unit edge normals (SAT axes), computed once
+    std::vector<Vector2> worldNormals;  // localNormals rotated into world space
     Vector2 localCenter;                // Geometric center of localVertices
     Vector2 worldCenter;                // Transformed geometric center
+    Rectangle worldAABB{};              // Bounds of worldVertices, refreshed by transform()
+
+    // SoA mirrors of the vertices (x[] / y[], padded to simd::kSimdWidth)
+    // feeding the SIMD transform / projection kernels. Filled by
+    // setLocalVertices(); polygons without them use the scalar AoS loops.
+    simd::SoAVertices localSoA;
+    simd::SoAVertices worldSoA;
 
     ConvexPolygon() = default;
     explicit ConvexPolygon(const std::vector<Vector2>& vertices);
 
+    // Replaces the outline and recomputes localCenter and localNormals.
+    // Use this instead of writing localVertices directly, otherwise the
+    // cached SAT axes go stale.
+    void setLocalVertices(const std::vector<Vector2>& vertices);
+
+    // Same as setLocalVertices() for data that was computed offline
+    // (ShapeAsset): the outline must be convex and `normals` its unique
+    // unit edge normals. Nothing is recomputed.
+    void setPrecomputed(std::vector<Vector2> vertices, std::vector<Vector2> normals, Vector2 center);
+
     // Transforms localVertices to worldVertices based on entity's state.
     // entityPosition is the world position of the pivot.
     // entityRotationDegrees is the rotation around the pivot.
     // entityScale is the scale applied around the pivot.
+    // Normals are only rotated: a uniform scale does not change their direction.
     void transform(Vector2 entityPosition, float entityRotationDegrees, float entityScale);
-    Rectangle getAABB() const;
+    Rectangle getAABB() const { return worldAABB; } // cached, no vertex walk
+    PolygonView view() const;          // world-space view for the SAT code
     void drawLines(Color color) const; // Draw world vertices as lines
 };
 
@@ -68,13 +107,17 @@ class CollisionShape {
 public:
     std::string name; // Optional: for debugging or identification
     std::vector<ConvexPolygon> polygons;
+    Rectangle worldBounds{};          // Union of the pieces' worldAABB, set by updateWorldVertices()
     // Note: The 'anchorPoint' or 'pivot' is implicitly handled by ensuring
     // ConvexPolygon::localVertices are pre-adjusted to be relative to the entity's desired pivot.
     // The entity's `position` member then becomes the world location of this pivot.
 
     CollisionShape() = default;
 
-    // Adds a pre-adjusted convex polygon (vertices are local to the entity's pivot)
+    // Adds a polygon (vertices are local to the entity's pivot).
+    // Convex outlines are stored as-is; concave ones are split into a few
+    // convex pieces first (see ShapeDecomposition), since SAT is only valid
+    // for convex polygons.
     void addPolygon(const std::vector<Vector2>& adjustedLocalVertices);
 
     // Updates the world-space representation of all constituent polygons
@@ -84,6 +127,93 @@ public:
     void drawLines(Color color) const;
 };
 
+// World-space state of one piece of a pooled shape instance. Offsets
+// index the pool's x / y / normal arrays (see ShapePool).
+struct PieceInstance {
+    uint32_t  soa = 0, padded = 0, count = 0;
+    uint32_t  normal = 0, normalCount = 0;
+    Vector2   center{0, 0};         // worldCenter
+    Rectangle aabb{};               // worldAABB
+};
+
+// Read-only view of a whole shape for the collision queries: either an
+// embedded CollisionShape or a ShapePool instance. Pool views point into
+// the pool's arrays and stay valid until the pool next grows (spawn).
+struct ShapeView {
+    const CollisionShape* shape = nullptr;   // embedded …
+    const PieceInstance*  pieces = nullptr;  // … or pooled
+    size_t                pieceCount = 0;
+    const float*          x = nullptr;
+    const float*          y = nullptr;
+    const Vector2*        normals = nullptr;
+    Rectangle             bounds{};
+
+    ShapeView() = default;
+    ShapeView(const CollisionShape& s);      // implicit: CollisionShape works wherever a view does
+
+    size_t      size() const;
+    bool        empty() const { return size() == 0; }
+    Rectangle   worldBounds() const;
+    PolygonView piece(size_t i) const;
+    void        drawLines(Color color) const;
+};
+
+// Result of a shape-vs-shape test. Every overlapping piece pair is looked at;
+// the deepest one decides the separating normal, so the resolution direction
+// does not depend on which piece happens to be tested first.
+struct ContactManifold {
+    Vector2 normal{0, 0};   // Unit separating axis, oriented from A towards B
+    float   depth  = 0.0f;  // Penetration along `normal` (deepest piece pair)
+    int     pieceA = -1;    // Piece index in shapeA of the deepest contact
+    int     pieceB = -1;    // Piece index in shapeB of the deepest contact
+    int     contacts = 0;   // Number of piece pairs that overlap
+
+    Vector2 mtv() const { return { normal.x * depth, normal.y * depth }; }
+};
+
+// Slab test: clips [tMin, tMax] to the part of the ray o + t·d inside `box`.
+// Shared by the broad-phase ray walk and RaycastShape.
+inline bool RayAABB(Vector2 o, Vector2 d, const Rectangle& box, float& tMin, float& tMax)
+{
+    const float lo[2]  = { box.x, box.y }, hi[2] = { box.x + box.width, box.y + box.height };
+    const float org[2] = { o.x, o.y },     dir[2] = { d.x, d.y };
+    for (int k = 0; k < 2; ++k)
+    {
+        if (dir[k] == 0.0f) {
+            if (org[k] < lo[k] || org[k] > hi[k]) return false;
+            continue;
+        }
+        float t0 = (lo[k] - org[k]) / dir[k], t1 = (hi[k] - org[k]) / dir[k];
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return false;
+    }
+    return true;
+}
+
+// --- Convex decomposition (run once, at shape-load time) ---
+namespace ShapeDecomposition {
+    // Signed area (shoelace). Positive and negative mean opposite windings.
+    float SignedArea(const std::vector<Vector2>& outline);
+
+    // True if the outline has no reflex vertex (collinear vertices allowed).
+    bool IsConvex(const std::vector<Vector2>& outline);
+
+    // Drops repeated / collinear vertices and makes the winding positive.
+    std::vector<Vector2> CleanOutline(const std::vector<Vector2>& outline);
+
+    // Splits a simple (non self-intersecting) outline into convex pieces:
+    // ear-clipping triangulation followed by Hertel-Mehlhorn merging, which
+    // removes every diagonal whose removal keeps both sides convex. The
+    // result has at most 4x the optimal number of pieces, usually far fewer.
+    // Falls back to the convex hull (with a warning) if the outline is not simple.
+    std::vector<std::vector<Vector2>> Decompose(const std::vector<Vector2>& outline);
+
+    // Convex hull (monotone chain), positive winding.
+    std::vector<Vector2> ConvexHull(std::vector<Vector2> points);
+} // namespace ShapeDecomposition
+
 // --- [DEPRECATED] It's not recommended to use this parser as it only works till txt file format for PhysicsEditor or other formats ---
 namespace ShapeParser {
     // [DEPRECATED] Not recommended for use in new code.
@@ -91,11 +221,11 @@ namespace ShapeParser {
     // Assumes vertices are for a single polygon.
     std::vector<Vector2> ParseVerticesFromString(const std::string& verticesStr);
 
-    // [DEPRECATED] Not recommended for use in new code.
-    // Example: Loads shapes from a PhysicsEditor plain text export.
-    // This is a conceptual function. A robust implementation would handle the full file format.
-    // It should parse the necessary body, extract its anchor point, and adjust all
-    // polygon vertices to be relative to that anchor point before creating ConvexPolygon objects.
+    // Loads one body from a PhysicsEditor plain text export.
+    // Reads the "Name: <bodyName>" section up to the next "Name:", takes
+    // AnchorPointAbs (or AnchorPointRel ⨉ imageSize) as the pivot and prefers
+    // "Convex sub polygons" over the "Hull polygon" (which gets decomposed).
+    // Offline use: tools/shapec turns the result into a .ashape file.
     // Returns a CollisionShape with localVertices already adjusted to be relative to the anchor.
     CollisionShape LoadFromPhysicsEditor(const std::string& fileContent,
                                          const std::string& bodyName,
@@ -119,6 +249,16 @@ namespace CollisionSystem {
      */
     void ProjectPolygon(const Vector2& axis, const std::vector<Vector2>& worldVertices, float& min, float& max);
 
+    /**
+     * @brief SIMD variant of ProjectPolygon on padded SoA vertices.
+     * 
+     * @param axis The axis onto which the vertices are projected.
+     * @param worldSoA The polygon's world vertices as padded x / y arrays.
+     * @param min Output parameter to store the minimum projection value.
+     * @param max Output parameter to store the maximum projection value.
+     */
+    void ProjectPolygon(const Vector2& axis, const simd::SoAVertices& worldSoA, float& min, float& max);
+
     /**
      * @brief Calculates the overlap between two 1D projections.
      * 
@@ -143,6 +283,9 @@ namespace CollisionSystem {
      * 
      * @param worldVertices The vertices of the convex polygon in world coordinates.
      * @return A vector containing the unique axes (normals) of the polygon.
+     *
+     * @note Only used by the reference SAT path now; ConvexPolygon caches its
+     *       axes in localNormals / worldNormals.
      */
     std::vector<Vector2> GetUniqueAxes(const std::vector<Vector2>& worldVertices);
 
@@ -152,6 +295,8 @@ namespace CollisionSystem {
      * This function checks for collision between two convex polygons using the
      * Separating Axis Theorem (SAT). If a collision is detected, it calculates
      * the Minimum Translation Vector (MTV) required to resolve the collision.
+     * The axes come from each polygon's cached worldNormals, so the check does
+     * no heap allocation and no sqrt.
      * 
      * @param polyA The first convex polygon.
      * @param polyB The second convex polygon.
@@ -161,29 +306,90 @@ namespace CollisionSystem {
     bool CheckSATCollision(const ConvexPolygon& polyA, const ConvexPolygon& polyB, Vector2& mtv);
 
     /**
-     * @brief Checks for collision between two collision shapes.
+     * @brief Reference SAT check: recomputes the axes from worldVertices every call.
      * 
-     * This function iterates through the constituent convex polygons of two collision
-     * shapes and performs SAT-based collision checks. If a collision is detected, it
-     * calculates the Minimum Translation Vector (MTV) required to resolve the collision.
+     * This is the original implementation, kept as the ground truth that the
+     * optimised paths are compared against. Avoid it in game code.
      * 
-     * @param shapeA The first collision shape.
-     * @param shapeB The second collision shape.
+     * @param polyA The first convex polygon.
+     * @param polyB The second convex polygon.
      * @param mtv Output parameter to store the Minimum Translation Vector (MTV) if a collision occurs.
      * @return True if a collision is detected, false otherwise.
      */
+    bool CheckSATCollisionReference(const ConvexPolygon& polyA, const ConvexPolygon& polyB, Vector2& mtv);
 
     /**
-     * @brief  */ 
+     * @brief Routes every shape-level SAT test through the reference path.
+     * 
+     * For A/B checks: `Aspace_replay compare --reference` re-tests every
+     * broad-phase pair of a replayed tick both ways on the same state.
+     * Whole runs on either path do not stay in step – ties between equally
+     * deep axes go another way. Change it between ticks only.
+     * 
+     * @param on True to test with CheckSATCollisionReference's algorithm.
+     */
+    void SetReferenceSAT(bool on);
+
+    /**
+     * @brief Whether SetReferenceSAT(true) is in effect.
+     */
+    bool ReferenceSATEnabled();
+
+    /**
+     * @brief Checks for collision between two collision shapes and builds a contact manifold.
+     * 
+     * Two-level test: the cached AABB of every piece is first checked against the
+     * other shape's bounds and then against each of its pieces; SAT only runs on
+     * piece pairs whose AABBs overlap. All SAT hits are accumulated and the
+     * deepest one is reported.
+     * 
+     * @param shapeA The first collision shape (embedded or pooled, see ShapeView).
+     * @param shapeB The second collision shape.
+     * @param manifold Output: normal (A → B), depth and piece indices of the deepest contact.
+     * @return True if a collision is detected, false otherwise.
+     */
+    bool CheckShapesCollide(const ShapeView& shapeA, const ShapeView& shapeB, ContactManifold& manifold);
+
     /**
      * @brief Checks if two collision shapes collide and calculates the minimum translation vector (MTV) if they do.
      * 
      * @param shapeA The first collision shape to check.
      * @param shapeB The second collision shape to check.
      * @param mtv A reference to a Vector2 that will store the minimum translation vector (MTV) if a collision is detected.
-     *            The MTV represents the smallest vector needed to separate the two shapes.
+     *            The MTV represents the smallest vector needed to separate the two shapes
+     *            (the deepest piece contact, see the ContactManifold overload).
      * @return true if the shapes collide, false otherwise.
      */
-    bool CheckShapesCollide(const CollisionShape& shapeA, const CollisionShape& shapeB, Vector2& mtv);
+    bool CheckShapesCollide(const ShapeView& shapeA, const ShapeView& shapeB, Vector2& mtv);
+
+    /**
+     * @brief Yes/no overlap test: stops at the first overlapping piece pair.
+     * 
+     * Use this for gameplay queries (hit tests, triggers) that do not need a
+     * resolution vector.
+     * 
+     * @param shapeA The first collision shape.
+     * @param shapeB The second collision shape.
+     * @return true if any piece of shapeA overlaps any piece of shapeB.
+     */
+    bool CheckShapesOverlap(const ShapeView& shapeA, const ShapeView& shapeB);
+
+    /**
+     * @brief Casts a ray against every convex piece of a shape.
+     * 
+     * Each piece AABB is slab-tested first; surviving pieces are clipped
+     * against their edges (Cyrus-Beck), so the hit lies on the actual outline.
+     * A ray starting inside a piece hits at distance 0 with normal -dir.
+     * 
+     * @param shape The collision shape (embedded or pooled).
+     * @param origin Start of the ray, world space.
+     * @param dir Unit direction of the ray.
+     * @param maxDist Only hits closer than this count.
+     * @param dist Output: distance along the ray to the nearest hit.
+     * @param normal Output: outward unit normal of the edge that was hit.
+     * @return true if the ray hits the shape within maxDist.
+     */
+    bool RaycastShape(const ShapeView& shape, Vector2 origin, Vector2 dir, float maxDist,
+                      float& dist, Vector2& normal);
 
 } // namespace CollisionSystem
\ No newline at end of file
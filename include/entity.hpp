@@ -1,7 +1,34 @@
 #pragma once
 #include <raylib.h>
 #include <string>
+#include <atomic>
+#include <cstdint>
 #include "collisionshapes.hpp"
+#include "shapedef.hpp"
+#include "entitypool.hpp"
+#include "inputstate.hpp"
+#include "renderqueue.hpp"
+#include "assetcache.hpp"
+#include "rng.hpp"
+
+class ReplayWriter;   // replay.hpp
+class ReplayReader;
+
+/* RPG numbers – read by gameplay events, never by the per-tick passes */
+struct EntityStats
+{
+    double damage      = 10.0;
+    double attackSpeed = 1.0;    // attacks/sec
+    double attackRange = 50.0;
+    double attackCD    = 0.0;    // seconds until next attack
+    double defense     = 0.0;
+    double mana        = 0.0, manaRegen = 0.0;
+    double stamina     = 0.0, stamRegen = 0.0;
+    double invincTimer = 0.0;
+    int    level       = 1;
+    int    xp          = 0;
+    bool   invincible  = false;
+};
 
 /*
  Abstract base class (interface) for every entity --------------------------
@@ -10,15 +37,27 @@
 class Entity {
 public:
     // ---------- Life-cycle --------------------------------------------------
-    virtual ~Entity()            { if (texture.id) UnloadTexture(texture); }
+    virtual ~Entity()            = default;   // textureRef releases its share
     Entity(const Entity&)        = delete;  
     Entity& operator=(const Entity&) = delete;
     Entity(Entity&&)             = default;  // movable
     Entity& operator=(Entity&&)  = default;
 
     // ---------- Core behaviour (default implementations) -------------------
-    virtual void update([[maybe_unused]] float dt, const Camera2D&) {}
-    virtual void draw(const Camera2D&) const {}
+    // `input` is the per-frame snapshot – never poll raylib from update()
+    virtual void update([[maybe_unused]] float dt, const InputState&) {}
+    // queue sprites for this frame; default = the hull texture at the render pose
+    virtual void submit(RenderQueue& q) const;
+    // debug overlay (AABB + SAT outline), drawn immediately when enabled
+    virtual void drawDebug() const;
+
+    // ---------- AI level of detail (opt-in) -------------------------------
+    // Entities that split update() into think() (decisions, steering: sets
+    // velocity) and coast() (motion) can set `aiLod`. World then calls
+    // think() only every few ticks when the entity is far from the camera –
+    // with the time since its last think – and coast() on every tick.
+    virtual void think([[maybe_unused]] float dt, const InputState&) {}
+    virtual void coast(float dt) { position.x += velocity.x * dt; position.y += velocity.y * dt; }
 
     // ---------- Gameplay API ------------------------------------------------
     virtual void takeDamage([[maybe_unused]] double amount) {}
@@ -26,21 +65,73 @@ public:
     virtual void attack([[maybe_unused]] Entity& target) {}
     virtual void onCollision([[maybe_unused]] Entity& other) {}
     virtual bool isAliveAndCollidable() { return isAlive && isCollidable; } // changed return type to bool
-    virtual void recalcOverallAABB(); // update AABB if needed
+    virtual void recalcOverallAABB(); // re-transform shape + AABB, skipped if the pose did not change
     inline Rectangle getOverallAABB() const { return overallAABB; } // AABB for this entity
 
+    // ---------- Collision shape --------------------------------------------
+    // Shared local geometry; the world copy lives in the World's ShapePool
+    // once spawned (embedded `shape` is only the authoring / standalone path).
+    void setShape(ShapeDefPtr def);            // *implemented in entity.cpp*
+    const ShapeDefPtr& shapeDefinition() const { return shapeDef; }
+    // World geometry for the collision queries, pooled or embedded
+    ShapeView collider() const { return shapePool ? shapePool->view(shapeSlot) : ShapeView(shape); }
+    // World::spawn – moves the shape into `pool` (an embedded outline is
+    // turned into a ShapeDef first); detach hands the slot back
+    void attachShapePool(ShapePool& pool);
+    void detachShapePool();
+
+    // ---------- Transform cache --------------------------------------------
+    // Setters flag the pose dirty; recalcOverallAABB() also notices direct
+    // writes to position / rotation / scale by comparing to the last pose.
+    void markTransformDirty()               { transformDirty = true; }
+    bool isTransformDirty() const;
+    // Number of shape transforms actually performed (all entities, all threads)
+    static uint64_t transformsPerformed()   { return s_transformCount.load(std::memory_order_relaxed); }
+    static void     resetTransformCounter() { s_transformCount.store(0, std::memory_order_relaxed); }
+
+    // ---------- Fixed-step interpolation -----------------------------------
+    // World keeps the last two tick poses (EntityTransforms) and hands the
+    // blended one to visible entities before submit(); off-screen entities
+    // keep whatever pose they were last drawn with (use World::transforms()).
+    void setRenderPose(Vector2 pos, float rot) { renderPos = pos; renderRot = rot; }
+    const Vector2& renderPosition() const { return renderPos; }
+    float          renderRotation() const { return renderRot; }
+
+    // ---------- Replay (replay.hpp) ----------------------------------------
+    // Class name a replay log stores (nullptr = cannot be replayed) and the
+    // setup state, beyond pose, size and the common knobs, a replay must
+    // restore – targets, steering modes. loadReplay() runs right after the
+    // replay spawned the entity around a size-only texture.
+    virtual const char* replayKind() const { return nullptr; }
+    virtual void saveReplay([[maybe_unused]] ReplayWriter& out) const {}
+    virtual void loadReplay([[maybe_unused]] ReplayReader& in) {}
+
     // ---------- Progression -------------------------------------------------
     virtual void levelUp() {}
     virtual void gainExperience([[maybe_unused]] int amount) {}
 
     // ---------- State setters ----------------------------------------------
-    virtual void setTexture(const std::string& path); // *implemented below*
-    virtual void setPosition(Vector2 pos)         { position = pos;  recalcOverallAABB(); }
-    virtual void setSize(Vector2 s)               { size = s;        recalcOverallAABB(); }
+    // load through Assets() – shared with every entity using the same file
+    virtual void setTexture(const std::string& path); // *implemented in entity.cpp*
+    void setTexture(TextureHandle handle);
+    // the texture to draw with: the shared handle if any, else the borrowed one
+    const Texture2D& drawTexture() const { return textureRef ? textureRef.get() : texture; }
+    // async handles: once the real texture is on the GPU, adopt its size
+    // (World calls this for visible entities before submit())
+    void pollTexture();
+    // what pollTexture() does to size, pivot and source region for a
+    // texture of `texSize` (a replay applies recorded swaps with it)
+    void fitToTexture(Vector2 texSize);
+    // after fitToTexture(): outlines derived from the size follow it here
+    virtual void onTextureFitted() {}
+    // Pose setters are lazy: they only flag the transform dirty. Call
+    // recalcOverallAABB() before reading world vertices / the AABB.
+    virtual void setPosition(Vector2 pos)         { position = pos;  markTransformDirty(); }
+    virtual void setSize(Vector2 s)               { size = s;        markTransformDirty(); }
     virtual void setHealth(double h)              { health = h; }
     virtual void setSpeed(double s)               { speed = s; }
-    virtual void setRotation(float r)         { rotation = r; }
-    virtual void setScale(float s)               { scale = s; recalcOverallAABB(); }
+    virtual void setRotation(float r)             { rotation = r;    markTransformDirty(); }
+    virtual void setScale(float s)                { scale = s;       markTransformDirty(); }
     // ... (other trivial setters can stay inline)
 
     // ---------- Query helpers (non-virtual) --------------------------------
@@ -48,40 +139,63 @@ public:
     const Rectangle& getCollision()   const { return collisionBox; }
     Vector2&   getMutablePosition() { return position; } // mutable access
     bool             alive()          const { return isAlive; }
+    bool             collidable()     const { return isCollidable; }
+    // stable reference for gameplay code; resolves through World::get()
+    EntityHandle     handle()         const { return worldHandle; }
+    // flag for removal: World reclaims the slot at the end of the frame
+    void             kill()                 { isAlive = false; }
 
     Entity() = default;
 
-    // Keep heavy data protected so derived classes can poke it ---------------
+    // Data is laid out hot → cold: the simulation passes only touch the
+    // first block; drawing adds the second; the rest is rarely read.
+
+    // ---------- hot: pose, bounds, flags ------------------------------------
     Vector2   position{0,0};
-    Vector2   size{64,64};
-    Texture2D texture{};           // RAII handled by ~Entity()
-    Vector2   offset{0,0};
+    Vector2   velocity{0,0};
+    float     rotation       = 0.0f;
+    float     scale          = 1.0f;  // scale factor for the entity
+    Rectangle overallAABB{};          // AABB for this entity
+    double    speed          = 100.0; // units/sec
+    bool      isAlive        = true;
+    bool      isColliding    = false;
+    bool      isCollidable   = true;
+    bool      aiLod          = false; // think()/coast() scheduling instead of update()
+    float     thinkDebt      = 0.0f;  // sim time since the last think()
+    int       gridProxy      = -1;    // slot in the broad-phase's proxy list (-1 = none)
+    uint32_t  worldIndex     = UINT32_MAX; // row in World's EntityTransforms
+    EntityHandle worldHandle{};       // set by World::spawn, stale after despawn
 
-    double health        = 100.0;
-    double speed         = 100.0;  // units/sec
-    double damage        = 10.0;
-    double attackSpeed   = 1.0;    // attacks/sec
-    double attackRange   = 50.0;
-    double attackCD      = 0.0;    // seconds until next attack
-    float rotation       = 0.0f;
-
-    bool   isAlive       = true;
-    bool   isColliding   = false; 
-    bool   isCollidable   = true;  
-    int    level         = 1;
-    int    xp            = 0;
-    float scale          = 1.0f; // scale factor for the entity
-    Color  tint          = WHITE;
+private:
+    // pose the shape / AABB were last computed for
+    Vector2 xformPosition{0,0};
+    float   xformRotation = 0.0f;
+    float   xformScale    = 1.0f;
+    bool    transformDirty = true;
+    ShapePool*      shapePool = nullptr;
+    ShapePool::Slot shapeSlot = ShapePool::INVALID;
 
-    Vector2   velocity{0,0};
-    Rectangle  overallAABB{}; // AABB for this entity
+    // blended pose to draw (set by World for visible entities)
+    Vector2 renderPos{0,0};
+    float   renderRot    = 0.0f;
+
+    static inline std::atomic<uint64_t> s_transformCount{0};
+
+public:
+    // ---------- warm: drawing ------------------------------------------------
+    Vector2   size{64,64};
+    Vector2   offset{0,0};
+    Color     tint          = WHITE;
+    Texture2D texture{};           // borrowed – never unloaded by the entity
+    Rectangle textureSrc{};        // region of `texture` to draw (empty = whole texture)
+    TextureHandle textureRef;      // owning share when loaded via AssetCache
     Rectangle collisionBox{};
-    double    defense         = 0.0;
-    double    mana            = 0.0, manaRegen = 0.0;
-    double    stamina         = 0.0, stamRegen = 0.0;
-    bool      invincible      = false;
-    double    invincTimer     = 0.0;
-    CollisionShape shape;
+    double    health        = 100.0;
+
+    // ---------- cold: authoring data, progression ---------------------------
+    CollisionShape shape;          // authored outline; emptied when pooled
+    EntityStats    stats;
+    Pcg32          rng;            // own stream, seeded by World::spawn from the handle
 
     void recalcCollision() {      // keep AABB in sync
         collisionBox = { position.x - size.x*0.5f,
@@ -89,6 +203,10 @@ public:
                          size.x, size.y };
     }
 
+private:
+    ShapeDefPtr shapeDef;
+
+public:
     // --- common helpers available to children ------------------------------
     static Vector2 lerp(Vector2 a, Vector2 b, float t) {
         return Vector2{ a.x + (b.x - a.x)*t, a.y + (b.y - a.y)*t };
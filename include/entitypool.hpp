@@ -0,0 +1,140 @@
+/* ──────────────────────────  entitypool.hpp  ──────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ entitypool.hpp — entity storage for World.
+//   • ObjectPool<T>: one per entity class; objects live in fixed-size
+//     chunks (addresses never move), freed slots go on a free list, so
+//     a warm pool spawns and despawns without touching the heap
+//   • EntityRegistry: handle table – slot index + generation. A handle
+//     to a despawned entity simply stops resolving (get() → nullptr),
+//     even after its slot has been reused
+//   Keep EntityHandles, not Entity*, across frames.
+// ────────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+class Entity;
+
+struct EntityHandle
+{
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    uint32_t index      = NONE;
+    uint32_t generation = 0;
+
+    // "refers to something"; whether it is still alive is World::get's call
+    explicit operator bool() const { return index != NONE; }
+    bool operator==(const EntityHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const EntityHandle& o) const { return !(*this == o); }
+};
+
+/* type-erased face of ObjectPool<T>, for the registry ------------------- */
+class PoolBase
+{
+public:
+    virtual ~PoolBase() = default;
+    virtual void   destroy(Entity* e)   = 0;   // runs ~T, recycles the slot
+    virtual size_t capacity() const     = 0;   // slots allocated so far
+    size_t         live() const         { return liveCount; }
+
+protected:
+    size_t liveCount = 0;
+};
+
+template<typename T>
+class ObjectPool final : public PoolBase
+{
+public:
+    // ~16 KB chunks, at least a handful of objects each
+    static constexpr size_t PER_CHUNK = std::max<size_t>(8, 16384 / sizeof(T));
+
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&)            = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    // every object must have been destroyed (World does that first)
+    ~ObjectPool() override = default;
+
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        if (freeSlots.empty()) grow();
+        void* mem = freeSlots.back();
+        T* obj = ::new (mem) T(std::forward<Args>(args)...);   // may throw: slot stays free
+        freeSlots.pop_back();
+        ++liveCount;
+        return obj;
+    }
+
+    void destroy(Entity* e) override
+    {
+        T* obj = static_cast<T*>(e);
+        obj->~T();
+        freeSlots.push_back(obj);
+        --liveCount;
+    }
+
+    size_t capacity() const override { return chunks.size() * PER_CHUNK; }
+
+private:
+    struct Chunk { alignas(T) unsigned char bytes[sizeof(T) * PER_CHUNK]; };
+
+    void grow()
+    {
+        chunks.push_back(std::make_unique<Chunk>());
+        unsigned char* base = chunks.back()->bytes;
+        freeSlots.reserve(freeSlots.size() + PER_CHUNK);
+        for (size_t i = PER_CHUNK; i-- > 0; ) freeSlots.push_back(base + i * sizeof(T));  // lowest first out
+    }
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<void*>                  freeSlots;
+};
+
+/* handle → entity ------------------------------------------------------- */
+class EntityRegistry
+{
+public:
+    EntityHandle add(Entity* e, PoolBase* pool)
+    {
+        uint32_t index;
+        if (!freeSlots.empty()) { index = freeSlots.back(); freeSlots.pop_back(); }
+        else                    { index = uint32_t(slots.size()); slots.push_back({}); }
+        slots[index].entity = e;
+        slots[index].pool   = pool;
+        return { index, slots[index].generation };
+    }
+
+    Entity* get(EntityHandle h) const
+    {
+        if (h.index >= slots.size()) return nullptr;
+        const Slot& s = slots[h.index];
+        return s.generation == h.generation ? s.entity : nullptr;
+    }
+
+    PoolBase* poolOf(EntityHandle h) const { return get(h) ? slots[h.index].pool : nullptr; }
+
+    // bumps the generation: every outstanding handle to it goes stale
+    void remove(EntityHandle h)
+    {
+        if (!get(h)) return;
+        Slot& s = slots[h.index];
+        s.entity = nullptr;
+        s.pool   = nullptr;
+        ++s.generation;
+        freeSlots.push_back(h.index);
+    }
+
+    size_t size() const { return slots.size() - freeSlots.size(); }
+
+private:
+    struct Slot { Entity* entity = nullptr; PoolBase* pool = nullptr; uint32_t generation = 1; };
+
+    std::vector<Slot>     slots;
+    std::vector<uint32_t> freeSlots;
+};
@@ -0,0 +1,86 @@
+/* ───────────────────────  entitytransforms.hpp  ───────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ entitytransforms.hpp — World's data-oriented view of its entities.
+//   One row per live entity (row == Entity::worldIndex == index into
+//   World's dense entity list), one array per field:
+//     • pose after the last tick and before it (interpolation)
+//     • overall AABB and the box the broad-phase currently holds
+//   Entities stay the source of truth for their pose (update() writes
+//   `position` directly); the worker that just ran an entity copies
+//   its pose + bounds in while the object is still in cache. The serial
+//   passes – grid sync, interpolation, sweep – then stream these arrays
+//   instead of walking the objects.
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Entity;
+
+struct EntityTransforms
+{
+    std::vector<Entity*> owner;
+    std::vector<float>   x, y, rot;                 // pose after the last tick
+    std::vector<float>   prevX, prevY, prevRot;     // pose before it
+    std::vector<Rectangle> aabb;                    // overall AABB
+    std::vector<Rectangle> grid;                    // box the broad-phase holds
+
+    size_t size() const { return owner.size(); }
+
+    // new row; pose and previous pose both `pos` / `r` (no smear on spawn)
+    uint32_t add(Entity* e, Vector2 pos, float r, Rectangle box)
+    {
+        owner.push_back(e);
+        x.push_back(pos.x);  y.push_back(pos.y);  rot.push_back(r);
+        prevX.push_back(pos.x); prevY.push_back(pos.y); prevRot.push_back(r);
+        aabb.push_back(box);
+        grid.push_back(box);
+        return uint32_t(owner.size() - 1);
+    }
+
+    // swap-and-pop; returns the entity that moved into row i (or nullptr)
+    Entity* swapRemove(size_t i)
+    {
+        const size_t last = owner.size() - 1;
+        auto move = [&](auto& v) { v[i] = v[last]; v.pop_back(); };
+        move(owner);
+        move(x); move(y); move(rot);
+        move(prevX); move(prevY); move(prevRot);
+        move(aabb); move(grid);
+        return i < owner.size() ? owner[i] : nullptr;
+    }
+
+    // start of a tick: what is current becomes previous
+    void savePrevious()
+    {
+        prevX = x; prevY = y; prevRot = rot;   // same sizes: plain copies, no allocation
+    }
+
+    void setPose(size_t i, Vector2 pos, float r) { x[i] = pos.x; y[i] = pos.y; rot[i] = r; }
+    void setPrevious(size_t i, Vector2 pos, float r) { prevX[i] = pos.x; prevY[i] = pos.y; prevRot[i] = r; }
+
+    // the broad-phase already holds exactly this box
+    bool gridBoxCurrent(size_t i) const
+    {
+        const Rectangle& a = aabb[i];
+        const Rectangle& g = grid[i];
+        return a.x == g.x && a.y == g.y && a.width == g.width && a.height == g.height;
+    }
+
+    Vector2 renderPosition(size_t i, float alpha) const
+    {
+        return { prevX[i] + (x[i] - prevX[i]) * alpha, prevY[i] + (y[i] - prevY[i]) * alpha };
+    }
+    // rotations wrap (atan2 / 0..360 clamping) – blend along the short arc
+    float renderRotation(size_t i, float alpha) const
+    {
+        float d = std::fmod(rot[i] - prevRot[i], 360.0f);
+        if (d >  180.0f) d -= 360.0f;
+        if (d < -180.0f) d += 360.0f;
+        return prevRot[i] + d * alpha;
+    }
+};
@@ -0,0 +1,40 @@
+/* ──────────────────────────  inputstate.hpp  ──────────────────────── */
+#pragma once
+#include <raylib.h>
+
+/*
+ Snapshot of everything the simulation may read from the player ------------
+ [Captured ONCE per frame on the main thread, before World::update.]
+ Entities get it by const& – they never call raylib input functions, so
+ updates can run on worker threads, headless, or from a recorded log.
+*/
+struct InputState
+{
+    Vector2 mouseScreen{0,0};      // pixels
+    Vector2 mouseWorld {0,0};      // mouseScreen through the camera
+    float   wheel        = 0.0f;   // GetMouseWheelMove()
+    bool    mouseLeft    = false;  // held
+    bool    mouseRight   = false;  // held
+    bool    ctrl         = false;  // either control key held
+    bool    toggleDebug    = false;  // F1 pressed this frame
+    bool    toggleProfiler = false;  // F2: profiler overlay
+    bool    captureTrace   = false;  // F3: write a Chrome trace
+    Vector2 screenSize {0,0};      // render target size in pixels
+
+    // Read raylib's input state (main thread only)
+    static InputState Capture(const Camera2D& camera)
+    {
+        InputState in;
+        in.mouseScreen = GetMousePosition();
+        in.mouseWorld  = GetScreenToWorld2D(in.mouseScreen, camera);
+        in.wheel       = GetMouseWheelMove();
+        in.mouseLeft   = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+        in.mouseRight  = IsMouseButtonDown(MOUSE_BUTTON_RIGHT);
+        in.ctrl        = IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL);
+        in.toggleDebug    = IsKeyPressed(KEY_F1);
+        in.toggleProfiler = IsKeyPressed(KEY_F2);
+        in.captureTrace   = IsKeyPressed(KEY_F3);
+        in.screenSize  = { (float)GetScreenWidth(), (float)GetScreenHeight() };
+        return in;
+    }
+};
@@ -0,0 +1,165 @@
+/* ──────────────────────────  jobsystem.hpp  ───────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ jobsystem.hpp — small work-stealing thread pool.
+//   • every worker owns a deque: it pops its own work from the back,
+//     idle workers steal from the front of the others
+//   • parallelFor() splits [0,count) into grain-sized chunks, spreads
+//     them over the deques and lets the calling thread help out until
+//     every chunk is done – no std::function, no per-job allocation
+//   • threads == 1 → no workers at all, everything runs inline on the
+//     caller (single-threaded debug mode)
+//   Jobs must not throw: an exception escaping a worker terminates.
+// ────────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "profiler.hpp"
+
+class JobSystem
+{
+public:
+    // threads = total threads taking part, the caller included.
+    // 0 picks std::thread::hardware_concurrency().
+    explicit JobSystem(unsigned threads = 0) { start(threads); }
+    ~JobSystem() { stop(); }
+
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void setThreadCount(unsigned threads) { stop(); start(threads); }
+    unsigned threadCount() const          { return unsigned(workers.size()) + 1; }
+    bool     singleThreaded() const       { return workers.empty(); }
+
+    /* Calls fn(begin, end) over [0, count) in chunks of `grain`.
+       Returns once every chunk has run. Chunk boundaries only depend on
+       count and grain, never on the thread count. */
+    template<typename Fn>
+    void parallelFor(size_t count, size_t grain, Fn&& fn)
+    {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        if (workers.empty() || count <= grain) {
+            for (size_t b = 0; b < count; b += grain) fn(b, std::min(count, b + grain));
+            return;
+        }
+
+        using F = std::remove_reference_t<Fn>;
+        const size_t chunks = (count + grain - 1) / grain;
+        std::atomic<size_t> remaining{ chunks };
+        auto trampoline = [](void* ctx, size_t b, size_t e) { (*static_cast<F*>(ctx))(b, e); };
+
+        {   // count first, so `pending` never dips below the real queue size
+            std::lock_guard<std::mutex> lk(sleepMx);
+            pending.fetch_add(chunks, std::memory_order_release);
+        }
+        for (size_t k = 0; k < chunks; ++k) {
+            Job j{ trampoline, (void*)&fn, k * grain, std::min(count, (k + 1) * grain), &remaining };
+            Queue& q = *queues[k % queues.size()];
+            std::lock_guard<std::mutex> lk(q.mx);
+            q.jobs.push_back(j);
+        }
+        sleepCv.notify_all();
+
+        // the caller works too instead of blocking
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            Job j;
+            if (steal(queues.size(), j)) run(j);
+            else std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Job {
+        void (*fn)(void*, size_t, size_t) = nullptr;
+        void*                ctx       = nullptr;
+        size_t               begin     = 0, end = 0;
+        std::atomic<size_t>* remaining = nullptr;
+    };
+    struct Queue {
+        std::mutex      mx;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::thread>            workers;
+    std::vector<std::unique_ptr<Queue>> queues;     // one per worker
+    std::atomic<size_t>                 pending{0}; // queued, not yet taken
+    std::atomic<bool>                   quitting{false};
+    std::mutex                          sleepMx;
+    std::condition_variable             sleepCv;
+
+    void start(unsigned threads)
+    {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        quitting = false;
+        queues.clear();
+        for (unsigned i = 1; i < threads; ++i) queues.push_back(std::make_unique<Queue>());
+        for (unsigned i = 1; i < threads; ++i) workers.emplace_back([this, i]{ workerLoop(i - 1); });
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lk(sleepMx);
+            quitting = true;
+        }
+        sleepCv.notify_all();
+        for (auto& t : workers) t.join();
+        workers.clear();
+    }
+
+    static void run(const Job& j)
+    {
+        j.fn(j.ctx, j.begin, j.end);
+        j.remaining->fetch_sub(1, std::memory_order_release);
+    }
+
+    bool popLocal(size_t self, Job& out)
+    {
+        Queue& q = *queues[self];
+        std::lock_guard<std::mutex> lk(q.mx);
+        if (q.jobs.empty()) return false;
+        out = q.jobs.back();
+        q.jobs.pop_back();
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // take the oldest job of any queue other than `self`
+    bool steal(size_t self, Job& out)
+    {
+        for (size_t k = 0; k < queues.size(); ++k) {
+            size_t victim = (self + 1 + k) % queues.size();
+            if (victim == self) continue;
+            Queue& q = *queues[victim];
+            std::lock_guard<std::mutex> lk(q.mx);
+            if (q.jobs.empty()) continue;
+            out = q.jobs.front();
+            q.jobs.pop_front();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(size_t self)
+    {
+        PROFILE_THREAD("job worker");
+        for (;;) {
+            Job j;
+            if (popLocal(self, j) || steal(self, j)) { run(j); continue; }
+
+            std::unique_lock<std::mutex> lk(sleepMx);
+            sleepCv.wait(lk, [&]{ return quitting.load() || pending.load(std::memory_order_acquire) > 0; });
+            if (quitting.load() && pending.load() == 0) return;
+        }
+    }
+};
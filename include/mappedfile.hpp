@@ -0,0 +1,36 @@
+/* ──────────────────────────  mappedfile.hpp  ──────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ mappedfile.hpp — read-only memory-mapped file.
+//   mmap on POSIX, MapViewOfFile on Windows. Kept free of raylib so
+//   the platform headers can live in their own translation unit
+//   (windows.h and raylib.h clash on Rectangle, CloseWindow, …).
+// ────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept { *this = static_cast<MappedFile&&>(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept;
+
+    bool open(const std::string& path);   // false if missing / empty / unmappable
+    void close();
+
+    const unsigned char* data() const { return bytes; }
+    size_t               size() const { return length; }
+    bool                 isOpen() const { return bytes != nullptr; }
+
+private:
+    const unsigned char* bytes  = nullptr;
+    size_t               length = 0;
+    void*                handle = nullptr;   // Windows: mapping object
+};
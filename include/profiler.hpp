@@ -0,0 +1,210 @@
+/* ───────────────────────────  profiler.hpp  ───────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ profiler.hpp — scoped timing zones and per-frame counters.
+//   • PROFILE_ZONE("name") times the enclosing scope, on any thread;
+//     PROFILE_COUNT adds to a per-frame counter, PROFILE_VALUE sets a
+//     gauge (last value wins), PROFILE_FRAME() closes the frame
+//   • every thread records into its own log; frame() (main thread)
+//     folds them into rolling averages over the last WINDOW frames –
+//     drawOverlay() shows those in game
+//   • beginCapture(path, frames) writes the next `frames` frames as
+//     Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+//   • ASPACE_PROFILE: 0 = macros compile to nothing (default with
+//     NDEBUG), 1 = zones + counters, 2 = also per-call zones in hot
+//     functions (PROFILE_ZONE_DETAIL, e.g. every SAT test)
+//   • ASPACE_TRACY: zones are also sent to Tracy, frames are marked
+//     and counters plotted there once per frame
+//   Names must be string literals (or otherwise outlive the program).
+// ────────────────────────────────────────────────────────────────
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(ASPACE_PROFILE)
+  #if defined(NDEBUG)
+    #define ASPACE_PROFILE 0
+  #else
+    #define ASPACE_PROFILE 1
+  #endif
+#endif
+
+#if defined(ASPACE_TRACY)
+  #include <tracy/Tracy.hpp>
+#endif
+
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_COUNTERS = 32;
+    static constexpr int    WINDOW       = 120;   // frames in the rolling averages
+
+    struct ZoneStats {
+        const char* name   = "";
+        int         depth  = 0;      // nesting of its first occurrence
+        double      avgMs  = 0.0;    // per frame, all calls summed
+        double      maxMs  = 0.0;    // worst frame in the window
+        double      calls  = 0.0;    // per frame
+    };
+    struct CounterStats {
+        const char* name  = "";
+        bool        gauge = false;
+        double      avg   = 0.0;      // per frame
+        int64_t     last  = 0;        // last frame
+    };
+
+    /* recording (any thread) -------------------------------------------- */
+    // a finished zone; depth = nesting level on its thread
+    void zone(const char* name, Clock::time_point begin, Clock::time_point end, int depth);
+    // retroactive span at the calling thread's current depth
+    void span(const char* name, Clock::time_point begin, Clock::time_point end) { zone(name, begin, end, Depth()); }
+
+    int  counterId(const char* name, bool gauge);   // -1 once MAX_COUNTERS are taken
+    void count(int id, int64_t n);
+    void setValue(int id, int64_t v);
+
+    void nameThread(const char* name);              // shown in captures
+
+    /* main thread ------------------------------------------------------- */
+    void frame();
+
+    const std::vector<ZoneStats>&    zones()    const { return zoneStats; }
+    const std::vector<CounterStats>& counters() const { return counterStats; }
+    double frameMs()    const { return frameAvgMs; }   // rolling average
+    double frameMaxMs() const { return frameWorstMs; }
+
+    // false if a capture is already running or the profiler is compiled out
+    bool beginCapture(std::string path, int frames);
+    bool capturing() const { return captureLeft > 0; }
+
+    void drawOverlay(int x, int y, int fontSize = 18) const;
+
+    static bool Enabled() { return ASPACE_PROFILE > 0; }
+    static int& Depth()   { static thread_local int depth = 0; return depth; }
+
+private:
+    struct Event  { const char* name; int64_t begin, end; int depth; };
+    struct Sample { int id; int64_t ts, value; };
+
+    struct ThreadLog {
+        std::mutex           mx;                    // events, name
+        std::vector<Event>   events;
+        const char*          name = nullptr;
+        uint32_t             tid  = 0;
+        std::atomic<int64_t> sums[MAX_COUNTERS] = {};
+    };
+    struct ZoneHistory {
+        ZoneStats stats;
+        double    ms[WINDOW]    = {};
+        uint32_t  calls[WINDOW] = {};
+    };
+    struct CounterSlot {
+        const char*          name  = "";
+        bool                 gauge = false;
+        std::atomic<int64_t> value{0};              // gauges
+        int64_t              hist[WINDOW] = {};
+    };
+
+    ThreadLog& local();
+    int64_t    ns(Clock::time_point t) const { return std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch).count(); }
+    void       writeCapture();
+
+    const Clock::time_point epoch = Clock::now();
+
+    std::mutex                               regMx;        // threads + counter names
+    std::vector<std::unique_ptr<ThreadLog>>  threads;
+    CounterSlot                              slots[MAX_COUNTERS];
+    std::atomic<int>                         slotCount{0};
+
+    // main thread only
+    std::vector<Event>                       scratch;
+    std::vector<ZoneHistory>                 history;
+    std::unordered_map<const char*, size_t>  byPtr;        // fast path
+    std::unordered_map<std::string, size_t>  byName;       // same literal, other TU
+    std::vector<ZoneStats>                   zoneStats;
+    std::vector<CounterStats>                counterStats;
+    double                                   frameHist[WINDOW] = {};
+    double                                   frameAvgMs   = 0.0;
+    double                                   frameWorstMs = 0.0;
+    int64_t                                  frameBegin   = 0;
+    uint64_t                                 frameIndex   = 0;
+
+    std::string                              capturePath;
+    int                                      captureLeft = 0;
+    std::vector<std::pair<uint32_t, Event>>  captured;     // (tid, event)
+    std::vector<Sample>                      capturedCounts;
+};
+
+// process-wide profiler; never destroyed, so threads that outlive main()
+// (asset loaders during exit) can still record safely
+inline Profiler& Profile()
+{
+    static Profiler* p = new Profiler;
+    return *p;
+}
+
+/* RAII zone behind PROFILE_ZONE ---------------------------------------- */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* n) : name(n), depth(Profiler::Depth()++), begin(Profiler::Clock::now()) {}
+    ~ProfileScope()
+    {
+        const auto end = Profiler::Clock::now();
+        --Profiler::Depth();
+        Profile().zone(name, begin, end, depth);
+    }
+    ProfileScope(const ProfileScope&)            = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char*                 name;
+    int                         depth;
+    Profiler::Clock::time_point begin;
+};
+
+#define ASPACE_PROF_CAT2(a, b) a##b
+#define ASPACE_PROF_CAT(a, b)  ASPACE_PROF_CAT2(a, b)
+
+#if ASPACE_PROFILE > 0
+  #if defined(ASPACE_TRACY)
+    #define ASPACE_TRACY_ZONE(name) ZoneScopedN(name)
+  #else
+    #define ASPACE_TRACY_ZONE(name) ((void)0)
+  #endif
+
+  #define PROFILE_ZONE(name)                                                      \
+      ASPACE_TRACY_ZONE(name);                                                    \
+      ProfileScope ASPACE_PROF_CAT(profileScope_, __LINE__)(name)
+  #define PROFILE_SPAN(name, begin, end)  Profile().span(name, begin, end)
+  #define PROFILE_COUNT(name, n)                                                  \
+      do { static const int id_ = Profile().counterId(name, false);               \
+           Profile().count(id_, int64_t(n)); } while (0)
+  #define PROFILE_VALUE(name, v)                                                  \
+      do { static const int id_ = Profile().counterId(name, true);                \
+           Profile().setValue(id_, int64_t(v)); } while (0)
+  #define PROFILE_THREAD(name)            Profile().nameThread(name)
+  #define PROFILE_FRAME()                 Profile().frame()
+#else
+  #define PROFILE_ZONE(name)              ((void)0)
+  #define PROFILE_SPAN(name, begin, end)  ((void)0)
+  #define PROFILE_COUNT(name, n)          ((void)0)
+  #define PROFILE_VALUE(name, v)          ((void)0)
+  #define PROFILE_THREAD(name)            ((void)0)
+  #define PROFILE_FRAME()                 ((void)0)
+#endif
+
+#if ASPACE_PROFILE > 1
+  #define PROFILE_ZONE_DETAIL(name)       PROFILE_ZONE(name)
+#else
+  #define PROFILE_ZONE_DETAIL(name)       ((void)0)
+#endif
+/* ───────────────────────────────────────────────────────────────────── */
@@ -0,0 +1,91 @@
+/* ─────────────────────────  renderqueue.hpp  ──────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ renderqueue.hpp — one draw stream per frame.
+//   • entities submit() textured quads instead of drawing directly
+//   • flush() sorts by layer → texture → submission order and issues
+//     the DrawTexturePro calls in one pass, so rlgl only has to switch
+//     textures when it really must
+//   • buffers are reused frame to frame: no allocation once warm
+//   Layers: hull = 0, parts behind the hull < 0, parts on top > 0.
+//   Same layer + same texture keeps submission order (stable).
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct DrawCommand
+{
+    Texture2D tex{};
+    Rectangle src{};
+    Rectangle dst{};
+    Vector2   origin{0,0};     // rotation pivot inside dst
+    float     rotation = 0.0f; // degrees
+    Color     tint     = WHITE;
+    int       layer    = 0;
+};
+
+class RenderQueue
+{
+public:
+    struct Stats {
+        size_t draws        = 0;  // DrawTexturePro calls issued
+        size_t batchBreaks  = 0;  // texture switches between consecutive draws
+        size_t textures     = 0;  // distinct textures touched
+    };
+
+    void clear() { commands.clear(); }
+
+    void push(const DrawCommand& cmd) { if (cmd.tex.id) commands.push_back(cmd); }
+
+    void push(const Texture2D& tex, Rectangle src, Rectangle dst,
+              Vector2 origin, float rotation, int layer, Color tint = WHITE)
+    {
+        push(DrawCommand{ tex, src, dst, origin, rotation, tint, layer });
+    }
+
+    size_t size() const { return commands.size(); }
+
+    // sort + draw everything queued since clear(); call inside BeginMode2D
+    void flush()
+    {
+        keys.clear();
+        keys.reserve(commands.size());
+        for (size_t i = 0; i < commands.size(); ++i) keys.push_back(makeKey(commands[i], uint32_t(i)));
+        std::sort(keys.begin(), keys.end());
+
+        last = {};
+        unsigned prevTex = 0;
+        texSeen.clear();
+        for (uint64_t k : keys)
+        {
+            const DrawCommand& c = commands[size_t(k & 0xFFFFFFFFu)];
+            if (last.draws && c.tex.id != prevTex) ++last.batchBreaks;
+            if (std::find(texSeen.begin(), texSeen.end(), c.tex.id) == texSeen.end()) texSeen.push_back(c.tex.id);
+            prevTex = c.tex.id;
+
+            DrawTexturePro(c.tex, c.src, c.dst, c.origin, c.rotation, c.tint);
+            ++last.draws;
+        }
+        last.textures = texSeen.size();
+    }
+
+    const Stats& stats() const { return last; }   // of the most recent flush()
+
+private:
+    // [layer:16 | texture id:16 | submission index:32]
+    static uint64_t makeKey(const DrawCommand& c, uint32_t index)
+    {
+        const uint64_t layer = uint16_t(std::clamp(c.layer, -32768, 32767) + 32768);
+        const uint64_t tex   = uint16_t(c.tex.id);
+        return (layer << 48) | (tex << 32) | index;
+    }
+
+    std::vector<DrawCommand> commands;
+    std::vector<uint64_t>    keys;
+    std::vector<unsigned>    texSeen;   // tiny: a handful of textures per frame
+    Stats                    last;
+};
@@ -0,0 +1,182 @@
+/* ───────────────────────────  replay.hpp  ─────────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ replay.hpp — deterministic record / replay of a World.
+//   • ReplayRecorder: attached with World::record() before the first
+//     tick, it logs the seed, tick length and broad-phase, every spawn
+//     (class name, pose, size, the entity's saveReplay() bytes), each
+//     tick's InputState and AI-LOD view as deltas, the world-side
+//     events between ticks (despawn, teleport, texture resize, frame
+//     end) and World::stateHash() after every tick
+//   • BasicReplayPlayer (replayplayer.hpp) rebuilds the world headless
+//     from a log and steps it tick by tick, checking every hash: the
+//     first tick that differs is where two builds / code paths part
+//   • whatever an entity reads during a tick must come from dt, the
+//     InputState or its own rng – gameplay code poking entities between
+//     frames (setTarget() every frame, …) is not in the log
+//   • little-endian on disk, floats as raw bits: a replay is exact
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "entitypool.hpp"
+#include "inputstate.hpp"
+
+class Entity;
+
+/* byte stream in / out ------------------------------------------------- */
+// Appends to a caller-owned buffer.
+class ReplayWriter
+{
+public:
+    explicit ReplayWriter(std::vector<uint8_t>& dst) : bytes(&dst) {}
+
+    void u8 (uint8_t v)  { bytes->push_back(v); }
+    void u16(uint16_t v) { put(v, 2); }
+    void u32(uint32_t v) { put(v, 4); }
+    void u64(uint64_t v) { put(v, 8); }
+    void f32(float v)    { uint32_t b; std::memcpy(&b, &v, 4); u32(b); }
+    void f64(double v)   { uint64_t b; std::memcpy(&b, &v, 8); u64(b); }
+    void vec2(Vector2 v) { f32(v.x); f32(v.y); }
+    void str(const std::string& s)   // at most 255 bytes
+    {
+        const size_t n = s.size() < 255 ? s.size() : 255;
+        u8(uint8_t(n));
+        bytes->insert(bytes->end(), s.begin(), s.begin() + std::ptrdiff_t(n));
+    }
+    void raw(const std::vector<uint8_t>& b) { bytes->insert(bytes->end(), b.begin(), b.end()); }
+
+    size_t size() const { return bytes->size(); }
+
+private:
+    void put(uint64_t v, int n) { for (int i = 0; i < n; ++i) bytes->push_back(uint8_t(v >> (8 * i))); }
+    std::vector<uint8_t>* bytes;
+};
+
+// Reading past the end yields zeros and clears ok() – check once at the end.
+class ReplayReader
+{
+public:
+    ReplayReader(const uint8_t* p, size_t n) : cur(p), end(p + n) {}
+
+    uint8_t  u8()   { return uint8_t(get(1)); }
+    uint16_t u16()  { return uint16_t(get(2)); }
+    uint32_t u32()  { return uint32_t(get(4)); }
+    uint64_t u64()  { return get(8); }
+    float    f32()  { const uint32_t b = u32(); float v;  std::memcpy(&v, &b, 4); return v; }
+    double   f64()  { const uint64_t b = u64(); double v; std::memcpy(&v, &b, 8); return v; }
+    Vector2  vec2() { const float x = f32(); return { x, f32() }; }
+    std::string str()
+    {
+        const size_t n = u8();
+        if (!take(n)) return {};
+        return std::string(reinterpret_cast<const char*>(cur - n), n);
+    }
+    // the next n bytes as a reader of their own
+    ReplayReader sub(size_t n) { return take(n) ? ReplayReader(cur - n, n) : ReplayReader(end, 0); }
+
+    bool ok()    const { return good; }
+    bool atEnd() const { return cur == end; }
+
+private:
+    bool take(size_t n)
+    {
+        if (size_t(end - cur) < n) { good = false; cur = end; return false; }
+        cur += n;
+        return true;
+    }
+    uint64_t get(int n)
+    {
+        if (!take(size_t(n))) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < n; ++i) v |= uint64_t(cur[i - n]) << (8 * i);
+        return v;
+    }
+    const uint8_t* cur;
+    const uint8_t* end;
+    bool           good = true;
+};
+
+/* a recording ---------------------------------------------------------- */
+enum class ReplayTag : uint8_t
+{
+    Kind     = 'K',   // class name → next kind id
+    Spawn    = 'S',
+    Tick     = 'T',   // input / view deltas, then the state hash after it
+    FrameEnd = 'F',   // World::endFrame(): the dead are swept here
+    Despawn  = 'D',
+    Teleport = 'P',
+    Resize   = 'R',   // an async texture arrived, size / pivot followed it
+    Seed     = 'N',   // World::setSeed() mid-recording
+};
+
+struct ReplayLog
+{
+    static constexpr uint32_t MAGIC   = 0x50525341;   // "ASRP"
+    static constexpr uint16_t VERSION = 1;
+
+    uint64_t    seed    = 0;     // World::getSeed() when recording began
+    float       tickDt  = 0.0f;  // exact dt of every step()
+    std::string grid;            // broad-phase NAME – pair order depends on it
+    std::string simd;            // info: backend of the recording build
+    uint32_t    threads = 0;     // info: thread count while recording
+    uint64_t    ticks   = 0;
+    std::vector<uint8_t> events; // ReplayTag records, in order
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);   // false if missing / not a log / other version
+};
+
+/* World::record() target ----------------------------------------------- */
+// Every call comes from BasicWorld on the main thread; nothing here is
+// for game code except log() / save().
+class ReplayRecorder
+{
+public:
+    // input bits of a Tick record
+    enum : uint8_t { MOUSE_SCREEN = 1, MOUSE_WORLD = 2, WHEEL = 4, BUTTONS = 8, SCREEN = 16, VIEW = 32 };
+
+    ReplayRecorder() = default;
+    ReplayRecorder(const ReplayRecorder&)            = delete;   // `w` points into `out`
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    void begin(uint64_t seed, float tickDt, const char* grid, unsigned threads);
+
+    // the spawn is written when the log next hears from the world, so
+    // setup done right after spawn() (parts, steering, targets) is in it
+    void spawned(const Entity& e, Vector2 spawnPos);
+    void despawned(EntityHandle h);
+    void teleported(EntityHandle h, Vector2 pos);
+    void resized(EntityHandle h, Vector2 size);
+    void reseeded(uint64_t seed);
+    void tick(const InputState& in, const Rectangle& lodView);   // before the tick runs
+    void tickDone(uint64_t stateHash);                           // after it
+    void frameEnd();
+
+    const ReplayLog& log() const { return out; }
+    bool     save(const std::string& path) const { return out.save(path); }
+    uint64_t ticks()  const { return out.ticks; }
+    size_t   bytes()  const { return out.events.size(); }
+    // spawns of classes without replayKind(): a replay refuses those logs
+    size_t   unreplayable() const { return unknown; }
+
+private:
+    struct Pending { const Entity* e; Vector2 spawnPos; Vector2 size; };
+
+    void     flush();   // pending spawns, oldest first
+    void     writeSpawn(const Pending& p);
+    uint16_t kindId(const char* name);
+    void     handle(EntityHandle h) { w.u32(h.index); w.u32(h.generation); }
+
+    ReplayLog                out;
+    ReplayWriter             w{ out.events };
+    std::vector<Pending>     pending;
+    std::vector<std::string> kinds;
+    InputState               lastIn{};
+    Rectangle                lastView{};
+    size_t                   unknown = 0;
+};
+/* ───────────────────────────────────────────────────────────────────── */
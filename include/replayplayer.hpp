@@ -0,0 +1,222 @@
+/* ─────────────────────────  replayplayer.hpp  ──────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ replayplayer.hpp — steps a World through a ReplayLog (replay.hpp).
+//   • spawns come back around size-only textures (nothing on the GPU),
+//     so a replay runs headless; every class in the log must have been
+//     registered with addKind<T>()
+//   • next() applies the log's events up to and including its next
+//     tick, then compares World::stateHash() with the recorded hash
+//   • a run on other threads or another SIMD backend must match every
+//     hash; the first tick that does not is firstDivergence(). Not the
+//     reference SAT path (CollisionSystem::SetReferenceSAT): it breaks
+//     axis ties differently, so its trajectories part at once – check
+//     it per pair on one world's state instead (Aspace_replay compare)
+// ────────────────────────────────────────────────────────────────
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include "world.hpp"
+#include "replay.hpp"
+
+template<typename GridT = UniformGrid>
+class BasicReplayPlayer
+{
+public:
+    using WorldT = BasicWorld<GridT>;
+
+    // T needs a (const Texture2D&, Vector2) constructor
+    template<typename T>
+    void addKind(const std::string& name = T::REPLAY_KIND)
+    {
+        spawners[name] = [](WorldT& w, Vector2 pos, const Texture2D& tex) -> Entity& {
+            return w.template spawn<T>(pos, tex);
+        };
+    }
+
+    // false (see error()) if the log was recorded on another broad-phase
+    // or `w` is not fresh; both must outlive the replay
+    bool start(const ReplayLog& l, WorldT& w)
+    {
+        log = nullptr; world = nullptr;
+        in  = ReplayReader(nullptr, 0);
+        kinds.clear();
+        input = {}; view = {};
+        played = mismatched = 0; firstBad = -1; matched = true;
+        err.clear();
+
+        if (l.grid != GridT::NAME)
+            return fail("log was recorded on the '" + l.grid + "' broad-phase, not '" + GridT::NAME + "'");
+        if (w.tickIndex() != 0 || w.entityCount() != 0) return fail("a replay needs a fresh world");
+
+        log   = &l;
+        world = &w;
+        in    = ReplayReader(l.events.data(), l.events.size());
+        w.setSeed(l.seed);
+        w.setTickRate(1.0f / l.tickDt);   // interpolation only: step() gets tickDt as recorded
+        return true;
+    }
+
+    // false at the end of the log or on a bad record (error() is set)
+    bool next()
+    {
+        if (!world || !err.empty()) return false;
+        while (!in.atEnd())
+        {
+            bool ok = true;
+            switch (ReplayTag(in.u8()))
+            {
+            case ReplayTag::Kind:     kinds.push_back(in.str()); break;
+            case ReplayTag::Spawn:    ok = spawn(); break;
+            case ReplayTag::Tick:     return tick();
+            case ReplayTag::FrameEnd: world->endFrame(); break;
+            case ReplayTag::Seed:     world->setSeed(in.u64()); break;
+            case ReplayTag::Despawn:
+                if (Entity* e = entity()) world->despawn(*e); else ok = false;
+                break;
+            case ReplayTag::Teleport: {
+                Entity* e = entity();
+                const Vector2 pos = in.vec2();
+                if (e) world->teleport(*e, pos); else ok = false;
+                break;
+            }
+            case ReplayTag::Resize: {
+                Entity* e = entity();
+                const Vector2 size = in.vec2();
+                if (e) e->fitToTexture(size); else ok = false;
+                break;
+            }
+            default: return fail("unknown record");
+            }
+            if (!in.ok()) return fail("truncated log");
+            if (!ok)      return false;
+        }
+        return false;
+    }
+
+    uint64_t ticks()           const { return played; }
+    bool     lastMatched()     const { return matched; }      // hash of the last tick
+    uint64_t recordedHash()    const { return expected; }
+    uint64_t replayedHash()    const { return actual; }
+    uint64_t mismatches()      const { return mismatched; }
+    int64_t  firstDivergence() const { return firstBad; }     // tick index, -1 = none
+    const std::string& error() const { return err; }
+
+private:
+    using Spawner = Entity& (*)(WorldT&, Vector2, const Texture2D&);
+
+    bool fail(std::string why)
+    {
+        err = "tick " + std::to_string(world ? world->tickIndex() : 0) + ": " + std::move(why);
+        return false;
+    }
+
+    Entity* entity()
+    {
+        EntityHandle h;
+        h.index      = in.u32();
+        h.generation = in.u32();
+        Entity* e = world->get(h);
+        if (!e && in.ok()) fail("event for entity " + std::to_string(h.index) + " which is not there");
+        return e;
+    }
+
+    bool spawn()
+    {
+        const uint16_t kind = in.u16();
+        EntityHandle h;
+        h.index      = in.u32();
+        h.generation = in.u32();
+        const Vector2 spawnPos = in.vec2();
+        const Vector2 size     = in.vec2();
+        const Vector2 pos      = in.vec2();
+        const float   rot      = in.f32();
+        const float   scale    = in.f32();
+        const double  speed    = in.f64();
+        const uint8_t flags    = in.u8();
+        ReplayReader  extra    = in.sub(in.u16());
+        if (!in.ok()) return fail("truncated log");
+
+        if (kind >= kinds.size()) return fail("spawn of an undeclared kind");
+        const std::string& name = kinds[kind];
+        auto it = spawners.find(name);
+        if (it == spawners.end())
+            return fail(name.empty() ? "the recording spawned a class without replayKind()"
+                                     : "no addKind() for " + name);
+
+        // what the constructor saw: a texture of the recorded size
+        const Texture2D standIn { 0, int(std::lround(size.x)), int(std::lround(size.y)), 1,
+                                  PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        Entity& e = it->second(*world, spawnPos, standIn);
+        if (e.handle() != h) return fail("spawn got handle " + std::to_string(e.handle().index) +
+                                         ", recorded " + std::to_string(h.index));
+
+        e.isCollidable = (flags & 1) != 0;
+        e.aiLod        = (flags & 2) != 0;
+        if (!(flags & 4)) e.kill();
+        e.speed = speed;
+        e.loadReplay(extra);
+
+        // setup moved it between spawn() and the first tick
+        if (!same(pos, spawnPos) || !same(rot, e.rotation) || !same(scale, e.scale))
+        {
+            e.setRotation(rot);
+            e.setScale(scale);
+            world->teleport(e, pos);
+        }
+        return true;
+    }
+
+    bool tick()
+    {
+        const uint8_t mask = in.u8();
+        if (mask & ReplayRecorder::MOUSE_SCREEN) input.mouseScreen = in.vec2();
+        if (mask & ReplayRecorder::MOUSE_WORLD)  input.mouseWorld  = in.vec2();
+        if (mask & ReplayRecorder::WHEEL)        input.wheel       = in.f32();
+        if (mask & ReplayRecorder::BUTTONS)
+        {
+            const uint8_t b = in.u8();
+            input.mouseLeft      = b & 1;   input.mouseRight   = b & 2;
+            input.ctrl           = b & 4;   input.toggleDebug  = b & 8;
+            input.toggleProfiler = b & 16;  input.captureTrace = b & 32;
+        }
+        if (mask & ReplayRecorder::SCREEN) input.screenSize = in.vec2();
+        if (mask & ReplayRecorder::VIEW)
+        {
+            const Vector2 p = in.vec2(), s = in.vec2();
+            view = { p.x, p.y, s.x, s.y };
+        }
+        if (!in.ok()) return fail("truncated log");
+
+        world->step(log->tickDt, input, view);
+        expected = in.u64();
+        if (!in.ok()) return fail("truncated log");
+
+        actual  = world->stateHash();
+        matched = actual == expected;
+        if (!matched && mismatched++ == 0) firstBad = int64_t(world->tickIndex() - 1);
+        ++played;
+        return true;
+    }
+
+    static bool same(float a, float b)     { return std::memcmp(&a, &b, sizeof a) == 0; }
+    static bool same(Vector2 a, Vector2 b) { return same(a.x, b.x) && same(a.y, b.y); }
+
+    std::unordered_map<std::string, Spawner> spawners;
+    const ReplayLog*         log   = nullptr;
+    WorldT*                  world = nullptr;
+    ReplayReader             in{ nullptr, 0 };
+    std::vector<std::string> kinds;     // id → name, as the log declares them
+    InputState               input{};
+    Rectangle                view{};
+    uint64_t                 played = 0, mismatched = 0;
+    uint64_t                 expected = 0, actual = 0;
+    int64_t                  firstBad = -1;
+    bool                     matched  = true;
+    std::string              err;
+};
+
+using ReplayPlayer = BasicReplayPlayer<UniformGrid>;
+/* ───────────────────────────────────────────────────────────────────── */
@@ -0,0 +1,55 @@
+/* ─────────────────────────────  rng.hpp  ──────────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ rng.hpp — PCG32 (XSH-RR 64/32), small and fast enough for one per
+//   entity: 16 bytes of state, no heap, trivial to construct.
+//   • (seed, stream) pairs give independent sequences, so an entity can
+//     own a stream keyed by its id instead of sharing a global engine
+//   • same numbers on every platform / standard library – use range()
+//     and nextFloat() rather than <random> distributions, whose output
+//     is implementation-defined
+//   • still a UniformRandomBitGenerator where <random> is fine
+// ────────────────────────────────────────────────────────────────
+
+#include <cstdint>
+
+class Pcg32
+{
+public:
+    using result_type = uint32_t;
+
+    Pcg32() : Pcg32(0x853c49e6748fea9bull, 0xda3e39cb94b95bdbull) {}
+    Pcg32(uint64_t seed, uint64_t stream) { reseed(seed, stream); }
+
+    void reseed(uint64_t seed, uint64_t stream)
+    {
+        state = 0;
+        inc   = (stream << 1u) | 1u;          // must be odd
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next()
+    {
+        const uint64_t old = state;
+        state = old * 6364136223846793005ull + inc;
+        const uint32_t xorshifted = uint32_t(((old >> 18u) ^ old) >> 27u);
+        const uint32_t rot        = uint32_t(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // [0, 1) with 24 bits of precision
+    float nextFloat() { return float(next() >> 8) * (1.0f / 16777216.0f); }
+    // [lo, hi)
+    float range(float lo, float hi) { return lo + (hi - lo) * nextFloat(); }
+
+    /* UniformRandomBitGenerator */
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()()          { return next(); }
+
+private:
+    uint64_t state = 0;
+    uint64_t inc   = 1;
+};
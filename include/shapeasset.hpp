@@ -0,0 +1,87 @@
+/* ──────────────────────────  shapeasset.hpp  ──────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ shapeasset.hpp — precompiled collision shapes (.ashape).
+//   The file is the final runtime data: convex pieces (already
+//   decomposed), their unique SAT normals, centres and local AABBs.
+//   Loading = mmap + header check; instantiate() only copies floats.
+//   Write files with tools/shapec (PhysicsEditor text → .ashape).
+//
+//   Layout (little-endian, every field 4 bytes):
+//     AshapeHeader
+//     AshapePiece   pieces  [pieceCount]
+//     float         vertices[vertexCount * 2]   (x, y)
+//     float         normals [normalCount * 2]   (x, y), unit length
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "collisionshapes.hpp"
+#include "mappedfile.hpp"
+#include "shapedef.hpp"
+
+struct AshapeHeader
+{
+    char     magic[4];        // "ASHP"
+    uint32_t version;         // ASHAPE_VERSION
+    uint32_t pieceCount;
+    uint32_t vertexCount;     // over all pieces
+    uint32_t normalCount;     // over all pieces
+    uint32_t reserved;
+    float    bounds[4];       // local AABB of the whole shape: x, y, w, h
+};
+
+struct AshapePiece
+{
+    uint32_t firstVertex, vertexCount;
+    uint32_t firstNormal, normalCount;
+    float    center[2];       // localCenter
+    float    bounds[4];       // local AABB: x, y, w, h
+};
+
+static_assert(sizeof(AshapeHeader) == 40, "AshapeHeader must stay packed");
+static_assert(sizeof(AshapePiece)  == 40, "AshapePiece must stay packed");
+
+inline constexpr uint32_t ASHAPE_VERSION = 1;
+
+/*
+ Immutable, memory-mapped shape ------------------------------------------
+ [Share one per file: ShapeAsset::Load caches by path.]
+*/
+class ShapeAsset
+{
+public:
+    // nullptr if missing or malformed (logged); the same pointer for the
+    // same path while anyone still holds it
+    static std::shared_ptr<const ShapeAsset> Load(const std::string& path);
+
+    // Serialise an already-built shape (pieces must be convex, normals set)
+    static bool Write(const std::string& path, const CollisionShape& shape);
+
+    // Fresh CollisionShape with this geometry – no decomposition, no normals
+    CollisionShape instantiate(const std::string& name = {}) const;
+
+    // The geometry as a shared ShapeDef, built once at load: hand this to
+    // Entity::setShape so every instance shares one local outline
+    const ShapeDefPtr& def() const { return sharedDef; }
+
+    size_t    pieceCount()   const { return header->pieceCount; }
+    size_t    vertexCount()  const { return header->vertexCount; }
+    Rectangle localBounds()  const { return { header->bounds[0], header->bounds[1], header->bounds[2], header->bounds[3] }; }
+    const AshapePiece& piece(size_t i) const { return pieces[i]; }
+    const std::string& path() const { return sourcePath; }
+
+private:
+    ShapeAsset() = default;
+    bool map(const std::string& path);   // validates every offset
+
+    MappedFile          file;
+    std::string         sourcePath;
+    const AshapeHeader* header   = nullptr;
+    const AshapePiece*  pieces   = nullptr;
+    const float*        vertices = nullptr;
+    const float*        normals  = nullptr;
+    ShapeDefPtr         sharedDef;
+};
@@ -0,0 +1,88 @@
+/* ───────────────────────────  shapedef.hpp  ───────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ shapedef.hpp — shared local geometry + pooled world geometry.
+//   • ShapeDef: the immutable local outline of a collision shape
+//     (convex pieces as padded SoA, SAT normals, centres, bounds).
+//     One per asset, shared by every entity using it (ShapeDefPtr).
+//   • ShapePool: the per-instance world vertices / normals / piece
+//     AABBs of ALL pooled entities in a few contiguous arrays, owned
+//     by World and indexed by the entity's slot.
+//   transform() on distinct slots touches disjoint ranges, so World's
+//   parallel update may run it concurrently; acquire() / release()
+//   resize the arrays and are main-thread only (spawn / despawn).
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "collisionshapes.hpp"
+
+struct ShapeDef;
+using ShapeDefPtr = std::shared_ptr<const ShapeDef>;
+
+struct ShapeDef
+{
+    struct Piece {
+        uint32_t  soa = 0, padded = 0, count = 0;   // slice of x / y
+        uint32_t  normal = 0, normalCount = 0;      // slice of normals
+        Vector2   center{0, 0};                     // localCenter
+        Rectangle bounds{};                         // local AABB
+    };
+
+    std::string          name;
+    std::vector<Piece>   pieces;
+    std::vector<float>   x, y;       // local vertices, every piece padded to simd::kSimdWidth
+    std::vector<Vector2> normals;    // unique unit edge normals, all pieces
+    Rectangle            bounds{};   // local AABB of the whole shape
+
+    // Shares the geometry of an authored shape (pieces must already be
+    // convex, as CollisionShape::addPolygon leaves them). Empty pieces are
+    // dropped; pieces without cached normals get them computed here.
+    static ShapeDefPtr FromShape(const CollisionShape& shape);
+
+    // Embedded copy, for entities that are not in a World
+    CollisionShape instantiate() const;
+
+    size_t vertexCount() const;
+};
+
+class ShapePool
+{
+public:
+    using Slot = uint32_t;
+    static constexpr Slot INVALID = UINT32_MAX;
+
+    // Reserves world storage for one instance of `def`. Reuses a released
+    // slot with the same layout when there is one, else appends.
+    Slot acquire(ShapeDefPtr def);
+    void release(Slot slot);
+
+    // Writes the instance's world geometry for this pose and returns its
+    // world bounds. Safe to call concurrently for different slots.
+    Rectangle transform(Slot slot, Vector2 position, float rotationDegrees, float scale);
+
+    // Current world geometry (valid until the next acquire())
+    ShapeView         view(Slot slot) const;
+    const ShapeDef&   def(Slot slot)  const { return *instances[slot].def; }
+    Rectangle         bounds(Slot slot) const { return instances[slot].bounds; }
+
+    size_t liveCount() const     { return instances.size() - freeSlots.size(); }
+    size_t bytesInUse() const;   // the pooled arrays, capacity included
+
+private:
+    struct Instance {
+        ShapeDefPtr def;
+        uint32_t    soa = 0, normal = 0, piece = 0;   // bases into the arrays below
+        Rectangle   bounds{};
+        bool        live = false;
+    };
+
+    std::vector<Instance>      instances;
+    std::vector<Slot>          freeSlots;
+    std::vector<float>         worldX, worldY;
+    std::vector<Vector2>       worldNormals;
+    std::vector<PieceInstance> worldPieces;
+};
@@ -0,0 +1,194 @@
+/* ─────────────────────────  simdkernels.hpp  ──────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ simdkernels.hpp — the two hot loops of the collision system on
+//   SoA vertex data (separate x / y float arrays):
+//     • TransformPoints : scale → rotate → translate
+//     • ProjectPoints   : dot-product min / max on one SAT axis
+//   Backend is picked at compile time: AVX2 → SSE2 → NEON → scalar.
+//   Every kernel has a *Scalar twin that is the reference result.
+//   Arrays must be padded to kSimdWidth (see PaddedCount) – pad with a
+//   copy of the last vertex so min/max projections are unaffected.
+//   Define ASPACE_SIMD_DISABLE to force the scalar path.
+// ────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#if !defined(ASPACE_SIMD_DISABLE)
+  #if defined(__AVX2__)
+    #include <immintrin.h>
+    #define ASPACE_SIMD_AVX2 1
+  #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ASPACE_SIMD_SSE2 1
+  #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define ASPACE_SIMD_NEON 1
+  #endif
+#endif
+
+namespace simd {
+
+// widest register we use (AVX2: 8 floats); SSE / NEON run two 4-wide steps
+inline constexpr size_t kSimdWidth = 8;
+
+inline constexpr size_t PaddedCount(size_t n) { return (n + kSimdWidth - 1) / kSimdWidth * kSimdWidth; }
+
+inline const char* BackendName()
+{
+#if defined(ASPACE_SIMD_AVX2)
+    return "AVX2";
+#elif defined(ASPACE_SIMD_SSE2)
+    return "SSE2";
+#elif defined(ASPACE_SIMD_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+/* ───────────────────────── SoA vertex storage ────────────────────── */
+struct SoAVertices
+{
+    std::vector<float> x, y;   // PaddedCount(count) entries each
+    size_t             count = 0;
+
+    // copy from any {x,y} array, padding with the last point
+    template<typename Vec2>
+    void assign(const std::vector<Vec2>& pts)
+    {
+        count = pts.size();
+        const size_t padded = PaddedCount(count);
+        x.resize(padded);
+        y.resize(padded);
+        for (size_t i = 0; i < padded; ++i) {
+            const Vec2& p = pts[std::min(i, count ? count - 1 : 0)];
+            x[i] = count ? p.x : 0.0f;
+            y[i] = count ? p.y : 0.0f;
+        }
+    }
+    size_t padded() const { return x.size(); }
+};
+
+/* ───────────────────────── scalar reference ──────────────────────── */
+inline void TransformPointsScalar(const float* lx, const float* ly, float* wx, float* wy, size_t n,
+                                  float cosT, float sinT, float scale, float tx, float ty)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const float x = lx[i] * scale;
+        const float y = ly[i] * scale;
+        wx[i] = tx + (x * cosT - y * sinT);
+        wy[i] = ty + (x * sinT + y * cosT);
+    }
+}
+
+inline void ProjectPointsScalar(const float* x, const float* y, size_t n,
+                                float ax, float ay, float& outMin, float& outMax)
+{
+    float mn = x[0] * ax + y[0] * ay, mx = mn;
+    for (size_t i = 1; i < n; ++i) {
+        const float p = x[i] * ax + y[i] * ay;
+        mn = std::min(mn, p);
+        mx = std::max(mx, p);
+    }
+    outMin = mn; outMax = mx;
+}
+
+/* ───────────────────────── vector backends ───────────────────────── */
+// n must be a multiple of kSimdWidth (use the padded size)
+inline void TransformPoints(const float* lx, const float* ly, float* wx, float* wy, size_t n,
+                            float cosT, float sinT, float scale, float tx, float ty)
+{
+#if defined(ASPACE_SIMD_AVX2)
+    const __m256 c = _mm256_set1_ps(cosT), s = _mm256_set1_ps(sinT), k = _mm256_set1_ps(scale);
+    const __m256 px = _mm256_set1_ps(tx),  py = _mm256_set1_ps(ty);
+    for (size_t i = 0; i < n; i += 8) {
+        const __m256 x = _mm256_mul_ps(_mm256_loadu_ps(lx + i), k);
+        const __m256 y = _mm256_mul_ps(_mm256_loadu_ps(ly + i), k);
+        _mm256_storeu_ps(wx + i, _mm256_add_ps(px, _mm256_sub_ps(_mm256_mul_ps(x, c), _mm256_mul_ps(y, s))));
+        _mm256_storeu_ps(wy + i, _mm256_add_ps(py, _mm256_add_ps(_mm256_mul_ps(x, s), _mm256_mul_ps(y, c))));
+    }
+#elif defined(ASPACE_SIMD_SSE2)
+    const __m128 c = _mm_set1_ps(cosT), s = _mm_set1_ps(sinT), k = _mm_set1_ps(scale);
+    const __m128 px = _mm_set1_ps(tx),  py = _mm_set1_ps(ty);
+    for (size_t i = 0; i < n; i += 4) {
+        const __m128 x = _mm_mul_ps(_mm_loadu_ps(lx + i), k);
+        const __m128 y = _mm_mul_ps(_mm_loadu_ps(ly + i), k);
+        _mm_storeu_ps(wx + i, _mm_add_ps(px, _mm_sub_ps(_mm_mul_ps(x, c), _mm_mul_ps(y, s))));
+        _mm_storeu_ps(wy + i, _mm_add_ps(py, _mm_add_ps(_mm_mul_ps(x, s), _mm_mul_ps(y, c))));
+    }
+#elif defined(ASPACE_SIMD_NEON)
+    const float32x4_t c = vdupq_n_f32(cosT), s = vdupq_n_f32(sinT), k = vdupq_n_f32(scale);
+    const float32x4_t px = vdupq_n_f32(tx),  py = vdupq_n_f32(ty);
+    for (size_t i = 0; i < n; i += 4) {
+        const float32x4_t x = vmulq_f32(vld1q_f32(lx + i), k);
+        const float32x4_t y = vmulq_f32(vld1q_f32(ly + i), k);
+        vst1q_f32(wx + i, vaddq_f32(px, vsubq_f32(vmulq_f32(x, c), vmulq_f32(y, s))));
+        vst1q_f32(wy + i, vaddq_f32(py, vaddq_f32(vmulq_f32(x, s), vmulq_f32(y, c))));
+    }
+#else
+    TransformPointsScalar(lx, ly, wx, wy, n, cosT, sinT, scale, tx, ty);
+#endif
+}
+
+inline void ProjectPoints(const float* x, const float* y, size_t n,
+                          float ax, float ay, float& outMin, float& outMax)
+{
+#if defined(ASPACE_SIMD_AVX2)
+    const __m256 vax = _mm256_set1_ps(ax), vay = _mm256_set1_ps(ay);
+    __m256 mn = _mm256_set1_ps(x[0] * ax + y[0] * ay), mx = mn;
+    for (size_t i = 0; i < n; i += 8) {
+        const __m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), vax),
+                                       _mm256_mul_ps(_mm256_loadu_ps(y + i), vay));
+        mn = _mm256_min_ps(mn, p);
+        mx = _mm256_max_ps(mx, p);
+    }
+    __m128 lo = _mm_min_ps(_mm256_castps256_ps128(mn), _mm256_extractf128_ps(mn, 1));
+    __m128 hi = _mm_max_ps(_mm256_castps256_ps128(mx), _mm256_extractf128_ps(mx, 1));
+    lo = _mm_min_ps(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_max_ps(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(2, 3, 0, 1)));
+    lo = _mm_min_ps(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 0, 3, 2)));
+    hi = _mm_max_ps(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    outMin = _mm_cvtss_f32(lo);
+    outMax = _mm_cvtss_f32(hi);
+#elif defined(ASPACE_SIMD_SSE2)
+    const __m128 vax = _mm_set1_ps(ax), vay = _mm_set1_ps(ay);
+    __m128 mn = _mm_set1_ps(x[0] * ax + y[0] * ay), mx = mn;
+    for (size_t i = 0; i < n; i += 4) {
+        const __m128 p = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), vax),
+                                    _mm_mul_ps(_mm_loadu_ps(y + i), vay));
+        mn = _mm_min_ps(mn, p);
+        mx = _mm_max_ps(mx, p);
+    }
+    mn = _mm_min_ps(mn, _mm_shuffle_ps(mn, mn, _MM_SHUFFLE(2, 3, 0, 1)));
+    mx = _mm_max_ps(mx, _mm_shuffle_ps(mx, mx, _MM_SHUFFLE(2, 3, 0, 1)));
+    mn = _mm_min_ps(mn, _mm_shuffle_ps(mn, mn, _MM_SHUFFLE(1, 0, 3, 2)));
+    mx = _mm_max_ps(mx, _mm_shuffle_ps(mx, mx, _MM_SHUFFLE(1, 0, 3, 2)));
+    outMin = _mm_cvtss_f32(mn);
+    outMax = _mm_cvtss_f32(mx);
+#elif defined(ASPACE_SIMD_NEON)
+    const float32x4_t vax = vdupq_n_f32(ax), vay = vdupq_n_f32(ay);
+    float32x4_t mn = vdupq_n_f32(x[0] * ax + y[0] * ay), mx = mn;
+    for (size_t i = 0; i < n; i += 4) {
+        const float32x4_t p = vaddq_f32(vmulq_f32(vld1q_f32(x + i), vax),
+                                        vmulq_f32(vld1q_f32(y + i), vay));
+        mn = vminq_f32(mn, p);
+        mx = vmaxq_f32(mx, p);
+    }
+  #if defined(__aarch64__) || defined(_M_ARM64)
+    outMin = vminvq_f32(mn);
+    outMax = vmaxvq_f32(mx);
+  #else
+    float32x2_t l = vpmin_f32(vget_low_f32(mn), vget_high_f32(mn));
+    float32x2_t h = vpmax_f32(vget_low_f32(mx), vget_high_f32(mx));
+    outMin = vget_lane_f32(vpmin_f32(l, l), 0);
+    outMax = vget_lane_f32(vpmax_f32(h, h), 0);
+  #endif
+#else
+    ProjectPointsScalar(x, y, n, ax, ay, outMin, outMax);
+#endif
+}
+
+} // namespace simd
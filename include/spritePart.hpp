@@ -1,23 +1,54 @@
 #pragma once
 #include "animator.hpp"
+#include "renderqueue.hpp"
 #include <cmath>
 
 
+// One attachment: which clip it plays and where. The playback cursor is
+// not in here – SpritePartSet keeps all of a ship's AnimationStates side
+// by side and passes the right one in.
 struct SpritePart
 {
-    Texture2D* tex  {};
-    Animation  anim;
+    const Texture2D* tex {}; // plain texture or atlas page
+    AnimationClipPtr clip;   // shared, never copied per part
     Vector2    local {};     // attachment point in *ship* space
     int        z     = 0;    // draw order (‑ve = behind hull)
     float      relRot= 0.f;  // extra spin for the part itself (optional)
     bool       active = true; // if false, don't draw this part
 
-    void update(float dt) { if(active) anim.Update(dt); }
+    // render layer relative to the hull (hull = 0, z >= 0 draws on top)
+    int layer() const { return z < 0 ? z : z + 1; }
 
-    void draw(Vector2 worldPos, float shipRotDeg) const
+    /* local offset from ship space → world space (rotation only) */
+    Vector2 rotatedLocal(float shipRotDeg) const
+    {
+        const float rad = shipRotDeg * DEG2RAD;
+        return { local.x * std::cos(rad) - local.y * std::sin(rad),
+                 local.x * std::sin(rad) + local.y * std::cos(rad) };
+    }
+
+    /* queue this part's current frame (same placement as draw()) */
+    void submit(RenderQueue& q, const AnimationState& st, Vector2 worldPos, float shipRotDeg) const
+    {
+        submit(q, st, worldPos, rotatedLocal(shipRotDeg), shipRotDeg);
+    }
+    // `off` = rotatedLocal(shipRotDeg), e.g. cached by SpritePartSet
+    void submit(RenderQueue& q, const AnimationState& st, Vector2 worldPos, Vector2 off, float shipRotDeg) const
+    {
+        if (!active || !tex || !clip || clip->FrameCount() == 0) return;
+
+        const Frame& f = clip->Current(st);
+        Rectangle dst { worldPos.x + off.x + f.offset.x,
+                        worldPos.y + off.y + f.offset.y,
+                        f.src.width, f.src.height };
+        q.push(*tex, f.src, dst, { f.src.width * 0.5f, f.src.height * 0.5f },
+               shipRotDeg + relRot, layer());
+    }
+
+    void draw(const AnimationState& st, Vector2 worldPos, float shipRotDeg) const
     {
 
-        if (!active) return;
+        if (!active || !tex || !clip || clip->FrameCount() == 0) return;
 
         /* rotate local offset from ship space → world space */
         const float rad = shipRotDeg * DEG2RAD;
@@ -27,11 +58,11 @@ struct SpritePart
         };
 
         /* compute pivot = centre of current frame */
-        const Frame& f = anim.Current();
+        const Frame& f = clip->Current(st);
         Vector2 pivot { f.src.width * 0.5f, f.src.height * 0.5f };
 
         /* draw: SAME rotation, SAME pivot ---------------------------------- */
-        anim.Draw(*tex,
+        clip->Draw(st, *tex,
                 worldPos, off,                // entityPos + rotated local
                 shipRotDeg + relRot,          // total rotation
                 1.0f,
@@ -0,0 +1,96 @@
+/* ─────────────────────────  spritepartset.hpp  ────────────────────── */
+#pragma once
+#include "spritePart.hpp"
+#include "renderqueue.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/*
+ Ordered collection of SpritePart attachments ------------------------------
+ [Shared by every ship that carries thrusters / weapons / effects.]
+ • parts are kept sorted by z when added – nothing is sorted per frame
+ • ids are handed out in insertion order and stay valid, so
+   `parts[0]` is always the first part added, wherever it sits by z
+ • the rotated attachment offsets are cached and only recomputed when
+   the ship's rotation changes; submit()/draw() never allocate
+ • clips are shared (AnimationClipPtr); each part only adds a 16-byte
+   AnimationState, and update() advances all of them in one pass over
+   two parallel arrays (clip, state) – inactive parts carry a null clip
+*/
+class SpritePartSet
+{
+public:
+    using PartId = size_t;
+
+    PartId add(SpritePart part)
+    {
+        // upper_bound → equal z keeps insertion order
+        auto it = std::upper_bound(parts.begin(), parts.end(), part.z,
+                                   [](int z, const SpritePart& p){ return z < p.z; });
+        const size_t slot = size_t(it - parts.begin());
+        const AnimationState start = part.clip ? part.clip->Start() : AnimationState{};
+        const AnimationClip* playing = part.active ? part.clip.get() : nullptr;
+        parts.insert(it, std::move(part));
+        states.insert(states.begin() + slot, start);
+        clips.insert(clips.begin() + slot, playing);
+
+        for (auto& s : slotOf) if (s >= slot) ++s;
+        slotOf.push_back(slot);
+        offsets.resize(parts.size());
+        cachedRot = NAN;                 // new part → offsets stale
+        return slotOf.size() - 1;
+    }
+
+    // move / toggle a part with setLocal() / setActive(), not via operator[]
+    // (keeps the offset cache and the playing list valid)
+    SpritePart&       operator[](PartId id)       { return parts[slotOf[id]]; }
+    const SpritePart& operator[](PartId id) const { return parts[slotOf[id]]; }
+    size_t size()  const { return parts.size(); }
+    bool   empty() const { return parts.empty(); }
+
+    void setLocal(PartId id, Vector2 local) { (*this)[id].local = local; cachedRot = NAN; }
+    // a hidden part also pauses: it resumes from the same frame
+    void setActive(PartId id, bool on)
+    {
+        SpritePart& p = (*this)[id];
+        p.active = on;
+        clips[slotOf[id]] = on ? p.clip.get() : nullptr;
+    }
+
+    // playback cursor of a part (e.g. restart it with clip->Start())
+    AnimationState&       state(PartId id)       { return states[slotOf[id]]; }
+    const AnimationState& state(PartId id) const { return states[slotOf[id]]; }
+
+    // advance every active part's animation
+    void update(float dt) { AdvanceAnimations(clips.data(), states.data(), states.size(), dt); }
+
+    // queue all parts around `pivotWorld`; the queue sorts them by layer
+    void submit(RenderQueue& q, Vector2 pivotWorld, float shipRotDeg) const
+    {
+        refreshOffsets(shipRotDeg);
+        for (size_t i = 0; i < parts.size(); ++i) parts[i].submit(q, states[i], pivotWorld, offsets[i], shipRotDeg);
+    }
+
+    // immediate-mode fallback, already in z order
+    void draw(Vector2 pivotWorld, float shipRotDeg) const
+    {
+        for (size_t i = 0; i < parts.size(); ++i) parts[i].draw(states[i], pivotWorld, shipRotDeg);
+    }
+
+private:
+    void refreshOffsets(float shipRotDeg) const
+    {
+        if (shipRotDeg == cachedRot) return;
+        for (size_t i = 0; i < parts.size(); ++i) offsets[i] = parts[i].rotatedLocal(shipRotDeg);
+        cachedRot = shipRotDeg;
+    }
+
+    std::vector<SpritePart>           parts;    // sorted by z
+    std::vector<AnimationState>       states;   // parallel to parts
+    std::vector<const AnimationClip*> clips;    // parallel to parts, null = inactive
+    std::vector<size_t>               slotOf;   // id → index in parts
+    mutable std::vector<Vector2>      offsets;  // rotated `local`, parallel to parts
+    mutable float                     cachedRot = NAN;
+};
@@ -0,0 +1,207 @@
+/* ─────────────────────────  textureatlas.hpp  ─────────────────────── */
+#pragma once
+// ────────────────────────────────────────────────────────────────
+// ▸ textureatlas.hpp — startup sprite packer.
+//   • add() / addDirectory() queue PNGs (optionally ⨉scale, nearest)
+//   • build() decodes them, packs them tallest-first onto shelves of
+//     one or a few pages and uploads each page as ONE Texture2D
+//   • sprite("file name without extension") → { page texture, src rect }
+//     which MakeStripAnimation / SpritePart / BasicShip take directly
+//   Images wider or taller than a page get a page of their own.
+//   The atlas owns its pages: keep it alive while sprites are in use.
+// ────────────────────────────────────────────────────────────────
+
+#include <raylib.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "profiler.hpp"
+
+/* A region of some texture – plain texture or atlas page */
+struct AtlasSprite
+{
+    const Texture2D* texture = nullptr;
+    Rectangle        src{};
+
+    explicit operator bool() const { return texture && texture->id; }
+};
+
+class TextureAtlas
+{
+public:
+    struct Options {
+        int  pageSize    = 4096;   // max page width / height in pixels
+        int  padding     = 2;      // transparent gap around every sprite
+        bool pointFilter = true;   // keep pixel art crisp
+    };
+
+    TextureAtlas() = default;
+    explicit TextureAtlas(Options o) : opt(o) {}
+    ~TextureAtlas() { unload(); }
+
+    TextureAtlas(const TextureAtlas&)            = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /* -- authoring ---------------------------------------------------- */
+    // queue one image; `name` is what sprite() looks it up by
+    void add(const std::string& name, const std::string& path, float scale = 1.0f)
+    {
+        pending.push_back({ name, path, scale });
+    }
+
+    // queue every PNG below `dir` (recursive) under its file name without
+    // extension; paths containing `skip` (preview sheets, …) are ignored
+    int addDirectory(const std::string& dir, float scale = 1.0f, const char* skip = "Preview")
+    {
+        FilePathList files = LoadDirectoryFilesEx(dir.c_str(), ".png", true);
+        int added = 0;
+        for (unsigned i = 0; i < files.count; ++i)
+        {
+            const char* path = files.paths[i];
+            if (skip && *skip && std::strstr(path, skip)) continue;
+            add(GetFileNameWithoutExt(path), path, scale);
+            ++added;
+        }
+        UnloadDirectoryFiles(files);
+        return added;
+    }
+
+    /* Decode, pack & upload everything queued. Replaces any previous
+       build – sprites handed out before are invalid afterwards. */
+    bool build()
+    {
+        PROFILE_ZONE("asset: atlas build");
+        unload();
+
+        // decode + scale ------------------------------------------------
+        std::vector<Source> src;
+        src.reserve(pending.size());
+        for (const auto& p : pending)
+        {
+            if (lookup.count(p.name)) {
+                TraceLog(LOG_WARNING, "ATLAS: duplicate sprite name '%s' (%s) skipped", p.name.c_str(), p.path.c_str());
+                continue;
+            }
+            Image img = LoadImage(p.path.c_str());
+            if (!img.data) { TraceLog(LOG_WARNING, "ATLAS: could not load %s", p.path.c_str()); continue; }
+            if (p.scale > 0.0f && p.scale != 1.0f)
+                ImageResizeNN(&img, int(img.width * p.scale), int(img.height * p.scale));
+            lookup[p.name] = {};                    // reserve the name
+            src.push_back({ p.name, img, -1, {} });
+        }
+        pending.clear();
+        if (src.empty()) return false;
+
+        // pack: tallest first onto shelves ------------------------------
+        std::vector<size_t> order(src.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (src[a].img.height != src[b].img.height) return src[a].img.height > src[b].img.height;
+            if (src[a].img.width  != src[b].img.width)  return src[a].img.width  > src[b].img.width;
+            return src[a].name < src[b].name;       // deterministic layout
+        });
+
+        const int pad = opt.padding, size = opt.pageSize;
+        std::vector<Shelf> shelves;                 // current shelf per page
+        std::vector<Vector2> extent;                // used width / height per page
+        for (size_t i : order)
+        {
+            const int w = src[i].img.width + pad*2, h = src[i].img.height + pad*2;
+
+            int page = -1;
+            if (w > size || h > size) {             // oversized → own page
+                page = int(shelves.size());
+                shelves.push_back({ 0, 0, 0, true });
+                extent.push_back({ 0, 0 });
+            } else {
+                page = pageWithRoom(shelves, w, h);
+                if (page < 0) {
+                    page = int(shelves.size());
+                    shelves.push_back({});
+                    extent.push_back({ 0, 0 });
+                }
+            }
+
+            Shelf& s = shelves[page];
+            if (s.x + w > size && !s.full) { s.y += s.h; s.x = 0; s.h = 0; }
+            src[i].page = page;
+            src[i].rect = { float(s.x + pad), float(s.y + pad), float(src[i].img.width), float(src[i].img.height) };
+            s.x += w;
+            s.h  = std::max(s.h, h);
+            extent[page].x = std::max(extent[page].x, float(s.x));
+            extent[page].y = std::max(extent[page].y, float(s.y + s.h));
+        }
+
+        // compose + upload ----------------------------------------------
+        std::vector<Image> canvas(shelves.size());
+        for (size_t p = 0; p < canvas.size(); ++p)
+            canvas[p] = GenImageColor(int(extent[p].x), int(extent[p].y), BLANK);
+        for (auto& s : src)
+        {
+            ImageDraw(&canvas[s.page], s.img, { 0, 0, float(s.img.width), float(s.img.height) }, s.rect, WHITE);
+            UnloadImage(s.img);
+            lookup[s.name] = { s.page, s.rect };
+        }
+        pages.reserve(canvas.size());
+        for (auto& img : canvas)
+        {
+            Texture2D tex = LoadTextureFromImage(img);
+            if (opt.pointFilter) SetTextureFilter(tex, TEXTURE_FILTER_POINT);
+            pages.push_back(tex);
+            UnloadImage(img);
+        }
+        TraceLog(LOG_INFO, "ATLAS: %d sprites packed into %d page(s)", int(src.size()), int(pages.size()));
+        return true;
+    }
+
+    void unload()
+    {
+        for (auto& t : pages) if (t.id) UnloadTexture(t);
+        pages.clear();
+        lookup.clear();
+    }
+
+    /* -- lookup ------------------------------------------------------- */
+    bool contains(const std::string& name) const { return lookup.count(name) != 0; }
+
+    // empty AtlasSprite (false) if the name is unknown
+    AtlasSprite sprite(const std::string& name) const
+    {
+        auto it = lookup.find(name);
+        if (it == lookup.end() || it->second.page < 0) {
+            TraceLog(LOG_WARNING, "ATLAS: no sprite named '%s'", name.c_str());
+            return {};
+        }
+        return { &pages[size_t(it->second.page)], it->second.rect };
+    }
+
+    size_t           pageCount()       const { return pages.size(); }
+    const Texture2D& page(size_t i)    const { return pages[i]; }
+    size_t           spriteCount()     const { return lookup.size(); }
+
+private:
+    struct Pending { std::string name, path; float scale; };
+    struct Source  { std::string name; Image img; int page; Rectangle rect; };
+    struct Entry   { int page = -1; Rectangle rect{}; };
+    struct Shelf   { int x = 0, y = 0, h = 0; bool full = false; };
+
+    // first page whose open shelf (or a new shelf below it) fits w×h
+    int pageWithRoom(const std::vector<Shelf>& shelves, int w, int h) const
+    {
+        for (size_t p = 0; p < shelves.size(); ++p)
+        {
+            const Shelf& s = shelves[p];
+            if (s.full) continue;
+            if (s.x + w <= opt.pageSize && s.y + std::max(s.h, h) <= opt.pageSize) return int(p);
+            if (s.y + s.h + h <= opt.pageSize) return int(p);   // next shelf
+        }
+        return -1;
+    }
+
+    Options                                opt;
+    std::vector<Pending>                   pending;
+    std::unordered_map<std::string, Entry> lookup;
+    std::vector<Texture2D>                 pages;
+};
@@ -11,6 +11,7 @@
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <cmath>
 #include <animator.hpp>
 
 namespace util {
@@ -93,35 +94,54 @@ inline Texture2D LoadTextureNNRotate90(const std::string& path,
 // ----------------------------------------------------------------
 // Slice a horizontal strip spritesheet into equal‑width Rectangles.
 // ----------------------------------------------------------------
-inline std::vector<Rectangle> SliceStrip(const Texture2D& tex, int frames)
+inline std::vector<Rectangle> SliceStrip(Rectangle region, int frames)
 {
-    const float w = static_cast<float>(tex.width) / frames;
-    const float h = static_cast<float>(tex.height);
+    const float w = region.width / frames;
     std::vector<Rectangle> rects(frames);
     for (int i = 0; i < frames; ++i)
-        rects[i] = { w * i, 0, w, h };
+        rects[i] = { region.x + w * i, region.y, w, region.height };
     return rects;
 }
 
+inline std::vector<Rectangle> SliceStrip(const Texture2D& tex, int frames)
+{
+    return SliceStrip(Rectangle{ 0, 0, (float)tex.width, (float)tex.height }, frames);
+}
+
 // ----------------------------------------------------------------
-// Create an Animation object from a simple strip in one call.
+// Create a shared AnimationClip from a simple strip in one call.
+// Every part that plays it shares the one frame list.
 // Example:
 //   auto flamesIdle = util::MakeStripAnimation("idle", flamesTex, 3, 0.1f);
+// Strips packed into an atlas page pass their region instead:
+//   util::MakeStripAnimation("idle", atlas.sprite("…").src, 3, 0.1f);
 // ----------------------------------------------------------------
-inline Animation MakeStripAnimation(const std::string&  name,
-                                    const Texture2D&   tex,
-                                    int                frames,
-                                    float              frameDuration,
-                                    Animation::LoopMode mode          = Animation::LoopMode::Loop,
-                                    float              playbackSpeed = 1.0f)
+inline AnimationClipPtr MakeStripAnimation(const std::string&  name,
+                                           Rectangle          region,
+                                           int                frames,
+                                           float              frameDuration,
+                                           AnimationClip::LoopMode mode      = AnimationClip::LoopMode::Loop,
+                                           float              playbackSpeed = 1.0f)
+{
+    AnimationClip clip(name, mode, playbackSpeed);
+    for (auto& rect : SliceStrip(region, frames))
+        clip.AddFrame(rect, frameDuration);
+    clip.setFramesOffsetToCenter();      // if center origin could wrap this in a if else later
+    return Share(std::move(clip));
+}
+
+inline AnimationClipPtr MakeStripAnimation(const std::string&  name,
+                                           const Texture2D&   tex,
+                                           int                frames,
+                                           float              frameDuration,
+                                           AnimationClip::LoopMode mode      = AnimationClip::LoopMode::Loop,
+                                           float              playbackSpeed = 1.0f)
 {
-    Animation anim(name, mode, playbackSpeed);
-    for (auto& rect : SliceStrip(tex, frames))
-        anim.AddFrame(rect, frameDuration);
-    anim.setFramesOffsetToCenter();      // if center origin could wrap this in a if else later
-    return anim;                         // RVO → cheap copy
+    return MakeStripAnimation(name, Rectangle{ 0, 0, (float)tex.width, (float)tex.height },
+                              frames, frameDuration, mode, playbackSpeed);
 }
 
+
 // ----------------------------------------------------------------
 // Helpers for basic math / interpolation — handy for smoothing
 // movement & camera pans.
@@ -129,6 +149,15 @@ inline Animation MakeStripAnimation(const std::string&  name,
 inline float  lerpf(float a, float b, float t)                  { return a + (b - a) * t; }
 inline Vector2 lerpVec2(Vector2 a, Vector2 b, float t)          { return { lerpf(a.x,b.x,t), lerpf(a.y,b.y,t) }; }
 
+// degrees → [0, 360), any input, no loops
+inline float wrapDegrees(float a)                               { a = std::fmod(a, 360.0f); return a < 0 ? a + 360.0f : a; }
+// shortest signed turn from `from` to `to`, in (-180, 180]
+inline float angleDelta(float from, float to)
+{
+    float d = wrapDegrees(to - from);
+    return d > 180.0f ? d - 360.0f : d;
+}
+
 template<typename T>
 inline T clamp(const T& v, const T& lo, const T& hi)            { return (v < lo) ? lo : (v > hi) ? hi : v; }
 
@@ -6,11 +6,30 @@
 #include <vector>
 #include "utilities.hpp"
 #include <algorithm>        
+#include <functional>
 #include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
 #include "collisionshapes.hpp"
 
 #include <entity.hpp>
+#include <entitypool.hpp>
+#include <entitytransforms.hpp>
+#include <broadphase.hpp>
+#include <jobsystem.hpp>
+#include <aischeduler.hpp>
+#include <cameracontroller.hpp>
+#include <renderqueue.hpp>
+#include <background.hpp>
+#include <profiler.hpp>
+#include <replay.hpp>
 #include <playercontroller.hpp>
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -18,6 +37,8 @@
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 class UniformGrid {
 public:
+    static constexpr const char* NAME = "uniform";
+
     UniformGrid(int worldW, int worldH, int cellSz)
         : cs(cellSz),
           cols((worldW + cellSz - 1) / cellSz),
@@ -26,14 +47,64 @@ public:
 
     void insert(Entity* e, const Rectangle& box)  { visitCells(box, [&](int i){ buckets[i].push_back(e); }); }
     void remove(Entity* e, const Rectangle& box)  { visitCells(box, [&](int i){ auto& v=buckets[i]; v.erase(std::remove(v.begin(),v.end(),e),v.end()); }); }
+    void rebuild() {}   // buckets are always current
+
+    // re-bucket only when the covered cell range actually changed
+    void update(Entity* e, const Rectangle& oldBox, const Rectangle& newBox)
+    {
+        if (sameCells(oldBox, newBox)) return;
+        remove(e, oldBox);
+        insert(e, newBox);
+    }
 
     template<typename Fn>
     void query(const Rectangle& area, Fn&& fn) const { visitCells(area, [&](int i){ for (auto* e : buckets[i]) fn(*e); }); }
+    // one cell, in bucket order; no dedup across cells
+    template<typename Fn>
+    void queryCell(int cx, int cy, Fn&& fn) const { for (auto* e : buckets[cy*cols + cx]) fn(*e); }
+
+    // every overlapping pair once; `out` is reused by the caller
+    void collectPairs(std::vector<EntityPair>& out) const
+    {
+        out.clear();
+        for (const auto& b : buckets)
+            for (size_t i = 0; i < b.size(); ++i)
+                for (size_t j = i + 1; j < b.size(); ++j)
+                {
+                    Entity* a = b[i];
+                    Entity* c = b[j];
+                    if (a == c || !AABBOverlap(a->getOverallAABB(), c->getOverallAABB())) continue;
+                    if (before(c, a)) std::swap(a, c);
+                    out.push_back({ a, c });
+                }
+
+        // a pair sharing several cells was emitted once per cell. Sorted by
+        // handle, not address: the same order in every run (ASLR, allocators)
+        auto less = [](const EntityPair& x, const EntityPair& y) {
+            return x.a != y.a ? before(x.a, y.a) : before(x.b, y.b);
+        };
+        auto same = [](const EntityPair& x, const EntityPair& y)
+                    { return x.a == y.a && x.b == y.b; };
+        std::sort(out.begin(), out.end(), less);
+        out.erase(std::unique(out.begin(), out.end(), same), out.end());
+    }
 
 private:
     int cs, cols, rows;
     std::vector<std::vector<Entity*>> buckets;
 
+    // handle first; the address only splits entities outside a World,
+    // which all share EntityHandle::NONE
+    static bool before(const Entity* a, const Entity* b) {
+        const uint32_t ia = a->handle().index, ib = b->handle().index;
+        return ia != ib ? ia < ib : std::less<const Entity*>()(a, b);
+    }
+
+    bool sameCells(const Rectangle& a, const Rectangle& b) const {
+        return int(a.x/cs) == int(b.x/cs) && int((a.x+a.width)/cs)  == int((b.x+b.width)/cs) &&
+               int(a.y/cs) == int(b.y/cs) && int((a.y+a.height)/cs) == int((b.y+b.height)/cs);
+    }
+
     template<typename Fn>
     void visitCells(const Rectangle& r, Fn&& fn) const {
         int minX = std::clamp(int(r.x              /cs), 0, cols-1);
@@ -45,194 +116,958 @@ private:
     }
 };
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   FlatGrid  – counting-sort grid, re-laid out once per frame
+   • insert/remove only touch a flat proxy list  (O(1), swap-and-pop)
+   • rebuild() packs every proxy into ONE contiguous entry array
+   • cells are generation-stamped: untouched cells are never cleared
+   • query() visits each entity once, even if it spans many cells
+   NOTE: the proxy index lives in Entity::gridProxy, so an entity can
+         only be registered in one FlatGrid at a time.
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class FlatGrid {
+public:
+    static constexpr const char* NAME = "flat";
+
+    FlatGrid(int worldW, int worldH, int cellSz)
+        : cs(cellSz),
+          cols((worldW + cellSz - 1) / cellSz),
+          rows((worldH + cellSz - 1) / cellSz),
+          spans(cols * rows),
+          cellStamp(cols * rows, 0) {}
+
+    void insert(Entity* e, const Rectangle& box)
+    {
+        e->gridProxy = int(proxies.size());
+        proxies.push_back({ e, box, cellRange(box) });
+    }
+
+    // O(1): just overwrite the proxy, the next rebuild() picks it up
+    void update(Entity* e, const Rectangle& /*oldBox*/, const Rectangle& newBox)
+    {
+        int i = e->gridProxy;
+        if (i < 0 || i >= int(proxies.size()) || proxies[i].e != e) { insert(e, newBox); return; }
+        proxies[i].box   = newBox;
+        proxies[i].range = cellRange(newBox);
+    }
+
+    void remove(Entity* e, const Rectangle& /*box*/)
+    {
+        int i = e->gridProxy;
+        if (i < 0 || i >= int(proxies.size()) || proxies[i].e != e) return;
+        proxies[i] = proxies.back();
+        proxies[i].e->gridProxy = i;
+        proxies.pop_back();
+        e->gridProxy = -1;
+    }
+
+    /* Lay the proxies out cell-by-cell (two-pass counting sort).
+       Queries see the layout of the last rebuild(); later insert/remove
+       calls only take effect on the next one. */
+    void rebuild()
+    {
+        if (++generation == 0) {                 // stamp wrapped: reset once
+            std::fill(cellStamp.begin(), cellStamp.end(), 0u);
+            generation = 1;
+        }
+        touched.clear();
+
+        // pass 1 – count entries per touched cell
+        for (const Proxy& p : proxies)
+            forRange(p.range, [&](int c){
+                if (cellStamp[c] != generation) {
+                    cellStamp[c] = generation;
+                    spans[c]     = { 0, 0 };
+                    touched.push_back(c);
+                }
+                ++spans[c].count;
+            });
+
+        // prefix sum over touched cells only
+        uint32_t offset = 0;
+        for (int c : touched) {
+            spans[c].start = offset;
+            offset        += spans[c].count;
+            spans[c].count = 0;
+        }
+
+        // pass 2 – scatter into the flat entry array
+        entries.resize(offset);
+        for (uint32_t slot = 0; slot < proxies.size(); ++slot) {
+            const Proxy& p = proxies[slot];
+            forRange(p.range, [&](int c){
+                CellSpan& s = spans[c];
+                entries[s.start + s.count++] = { p.e, slot };
+            });
+        }
+
+        layout.assign(proxies.begin(), proxies.end());
+        slotStamp.assign(proxies.size(), 0u);
+        queryStamp = 0;
+    }
+
+    /* Every overlapping pair exactly once. A pair that shares several
+       cells is only reported by the cell holding the top-left corner of
+       the overlap of their cell ranges, so no sort / hash is needed.
+       Pairs come out ordered by cell and slot, i.e. deterministically. */
+    void collectPairs(std::vector<EntityPair>& out) const
+    {
+        out.clear();
+        for (int c : touched)
+        {
+            const CellSpan& s = spans[c];
+            const int cx = c % cols, cy = c / cols;
+            for (uint32_t i = s.start; i < s.start + s.count; ++i)
+            {
+                const Proxy& pa = layout[entries[i].slot];
+                for (uint32_t j = i + 1; j < s.start + s.count; ++j)
+                {
+                    const Proxy& pb = layout[entries[j].slot];
+                    if (std::max(pa.range.minX, pb.range.minX) != cx ||
+                        std::max(pa.range.minY, pb.range.minY) != cy) continue;
+                    if (!AABBOverlap(pa.box, pb.box)) continue;
+                    out.push_back({ pa.e, pb.e });
+                }
+            }
+        }
+    }
+
+    template<typename Fn>
+    void query(const Rectangle& area, Fn&& fn) const
+    {
+        if (++queryStamp == 0) {
+            std::fill(slotStamp.begin(), slotStamp.end(), 0u);
+            queryStamp = 1;
+        }
+        forRange(cellRange(area), [&](int c){
+            if (cellStamp[c] != generation) return;  // empty this frame
+            const CellSpan& s = spans[c];
+            for (uint32_t i = s.start; i < s.start + s.count; ++i) {
+                const Entry& en = entries[i];
+                if (slotStamp[en.slot] == queryStamp) continue;
+                slotStamp[en.slot] = queryStamp;
+                fn(*en.e);
+            }
+        });
+    }
+
+    // one cell of the last rebuild(); no dedup across cells
+    template<typename Fn>
+    void queryCell(int cx, int cy, Fn&& fn) const
+    {
+        const int c = cy*cols + cx;
+        if (cellStamp[c] != generation) return;
+        const CellSpan& s = spans[c];
+        for (uint32_t i = s.start; i < s.start + s.count; ++i) fn(*entries[i].e);
+    }
+
+private:
+    struct Range    { int minX, minY, maxX, maxY; };
+    struct Proxy    { Entity* e; Rectangle box; Range range; };
+    struct Entry    { Entity* e; uint32_t slot; };
+    struct CellSpan { uint32_t start, count; };
+
+    int cs, cols, rows;
+    std::vector<Proxy>    proxies;     // one per registered entity
+    std::vector<Proxy>    layout;      // proxies as of the last rebuild
+    std::vector<Entry>    entries;     // all cells, back to back
+    std::vector<CellSpan> spans;       // per cell: slice of `entries`
+    std::vector<uint32_t> cellStamp;   // == generation → span is valid
+    std::vector<int>      touched;     // cells used by the last rebuild
+    uint32_t              generation = 0;
+
+    mutable std::vector<uint32_t> slotStamp;  // per-query dedup
+    mutable uint32_t              queryStamp = 0;
+
+    Range cellRange(const Rectangle& r) const
+    {
+        return { std::clamp(int(r.x              /cs), 0, cols-1),
+                 std::clamp(int(r.y              /cs), 0, rows-1),
+                 std::clamp(int((r.x+r.width)  /cs), 0, cols-1),
+                 std::clamp(int((r.y+r.height) /cs), 0, rows-1) };
+    }
+
+    template<typename Fn>
+    void forRange(const Range& r, Fn&& fn) const {
+        for (int y=r.minY; y<=r.maxY; ++y)
+            for (int x=r.minX; x<=r.maxX; ++x) fn(y*cols + x);
+    }
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   StepTimings – wall time of each phase of one World::step(), seconds
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+struct StepTimings
+{
+    double update      = 0.0;   // phase 1: entity logic + transforms
+    double grid        = 0.0;   // grid sync + rebuild (both passes)
+    double broadphase  = 0.0;   // collectPairs
+    double narrowphase = 0.0;   // SAT over the pair list
+    double resolve     = 0.0;   // corrections + re-transform
+    double total() const { return update + grid + broadphase + narrowphase + resolve; }
+};
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
    World – owns entities, camera, spatial grid
+   • GridT picks the broad-phase: UniformGrid (default), FlatGrid, or
+     SweepAndPrune (best when fleets bunch up into a few cells)
+   • entities live in one ObjectPool per class; dead ones (kill() /
+     despawn()) are swept at the end of update(), never mid-frame, so
+     Entity& / Entity* stay valid for the whole frame. Across frames
+     hold an EntityHandle and resolve it with get().
+   • pose, bounds and grid boxes are mirrored per tick into SoA rows
+     (EntityTransforms); the serial passes stream those, not objects
+   • aiLod entities think at a rate set by their distance to the
+     camera (AiScheduler) and coast on the ticks in between
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-class World {
+template<typename GridT = UniformGrid>
+class BasicWorld {
 public:
     /* public constants -------------------------------------------------- */
     static constexpr int WORLD_W   = 8192 * 2;
     static constexpr int WORLD_H   = 4096 * 2;
     static constexpr int CELL_SIZE = 512;
+    static constexpr int GRID_COLS = (WORLD_W + CELL_SIZE - 1) / CELL_SIZE;
+    static constexpr int GRID_ROWS = (WORLD_H + CELL_SIZE - 1) / CELL_SIZE;
+
+    /* job granularity (entities / pairs per chunk) ----------------------- */
+    static constexpr size_t UPDATE_GRAIN = 64;
+    static constexpr size_t PAIR_GRAIN   = 128;
+
+    /* fixed-step defaults ------------------------------------------------ */
+    static constexpr float DEFAULT_TICK_RATE = 120.0f;  // Hz
+    static constexpr int   DEFAULT_MAX_STEPS = 8;       // per rendered frame
+
+    /* per-entity RNG streams derive from this unless setSeed() ----------- */
+    static constexpr uint64_t DEFAULT_SEED = 0x41535041434531ull;
 
     /* ctor -------------------------------------------------------------- */
 
-    void setCameraTarget(Entity* e) {
-        cameraFollow = e;
+    void setCameraTarget(Entity* e)       { cameraFollow = e ? e->handle() : EntityHandle{}; }
+    void setCameraTarget(EntityHandle h)  { cameraFollow = h; }
+
+    BasicWorld(const char* bgTexPath = nullptr)
+    : grid(WORLD_W, WORLD_H, CELL_SIZE),
+      cam({ float(WORLD_W), float(WORLD_H) }, { (float)GetScreenWidth(), (float)GetScreenHeight() })
+    {
+        // the old full-world backdrop: decoded at native size and stretched
+        // ×2 with point filtering – same pixels as a ×2 decode, ¼ the VRAM
+        BackgroundLayerDesc backdrop;
+        backdrop.path     = bgTexPath ? bgTexPath : "../rsc/Environment/white_local_star_2.png";
+        backdrop.tileSize = { float(WORLD_W), float(WORLD_H) };
+        background.addLayer(std::move(backdrop));
     }
 
-    World(const char* bgTexPath = nullptr)
-    : grid(WORLD_W, WORLD_H, CELL_SIZE)
+    ~BasicWorld()
     {
-        camera.offset   = { GetScreenWidth()*0.5f, GetScreenHeight()*0.5f };
-        camera.rotation = 0.0f;
-        camera.zoom     = 1.0f;
-        camera.target   = { WORLD_W*0.5f, WORLD_H*0.5f };
-        backgroundTex = util::LoadTextureNN(bgTexPath ? bgTexPath : "../rsc/Environment/white_local_star_2.png", 2);
+        for (Entity* e : xforms.owner) registry.poolOf(e->handle())->destroy(e);
     }
 
+    BasicWorld(const BasicWorld&)            = delete;
+    BasicWorld& operator=(const BasicWorld&) = delete;
+
     /* generic spawner --------------------------------------------------- */
     template<typename T, typename... Args>
     T& spawn(Vector2 pos, Args&&... ctorArgs)
     {
         static_assert(std::is_base_of_v<Entity, T>, "spawn<T>: T must derive from Entity");
 
-        auto ptr = std::make_unique<T>(std::forward<Args>(ctorArgs)..., pos);
-        Entity& ref = *ptr;
-        entities.emplace_back(std::move(ptr));
+        ObjectPool<T>& pool = poolFor<T>();
+        Entity& ref = *pool.create(std::forward<Args>(ctorArgs)..., pos);
+        ref.worldHandle = registry.add(&ref, &pool);
+        // stream = slot, generation folded into the seed: a reused slot gets fresh numbers
+        ref.rng.reseed(seed ^ (uint64_t(ref.worldHandle.generation) << 32), ref.worldHandle.index);
 
-        grid.insert(&ref, ref.getCollision());
+        ref.attachShapePool(shapes);   // world vertices go into the shared pool
+        ref.recalcOverallAABB();
+        ref.worldIndex = xforms.add(&ref, ref.getPosition(), ref.rotation, ref.getOverallAABB());
+        ref.setRenderPose(ref.getPosition(), ref.rotation);
+        grid.insert(&ref, ref.getOverallAABB());
+        if (recorder) recorder->spawned(ref, pos);
 
         // if constexpr (std::is_base_of_v<CameraTarget, T>) cameraFollow = static_cast<CameraTarget*>(&ref);
         return static_cast<T&>(ref);
     }
-    void keepInside(Rectangle& box, Vector2& pos)
+    /* removal ----------------------------------------------------------- */
+    // Deferred: the entity keeps running to the end of this frame's ticks
+    // (skipped as dead) and is destroyed by the sweep in update().
+    void despawn(EntityHandle h) { if (Entity* e = get(h)) despawn(*e); }
+    void despawn(Entity& e)
+    {
+        if (recorder) recorder->despawned(e.handle());
+        e.kill();
+    }
+
+    // nullptr once the entity has been swept
+    Entity* get(EntityHandle h) const { return registry.get(h); }
+    template<typename T>
+    T* get(EntityHandle h) const { return dynamic_cast<T*>(registry.get(h)); }
+
+    size_t entityCount() const        { return xforms.size(); }
+    // SoA rows of every live entity, index = Entity::worldIndex (read-only)
+    const EntityTransforms& transforms() const { return xforms; }
+    size_t despawnedLastFrame() const { return sweptThisFrame; }
+
+    // returns true if the position had to be clamped
+    bool keepInside(Rectangle& box, Vector2& pos)
     {
         float halfW = box.width  * 0.5f;
         float halfH = box.height * 0.5f;
 
+        Vector2 before = pos;
         pos.x = std::clamp(pos.x, halfW, WORLD_W - halfW);
         pos.y = std::clamp(pos.y, halfH, WORLD_H - halfH);
 
         box.x = pos.x - halfW;
         box.y = pos.y - halfH;
+        return before.x != pos.x || before.y != pos.y;
     }
 
+    /* randomness ------------------------------------------------------- */
+    // seeds the Entity::rng of everything spawned from now on
+    void     setSeed(uint64_t s) { seed = s; if (recorder) recorder->reseeded(s); }
+    uint64_t getSeed() const     { return seed; }
+
+    /* AI level of detail ------------------------------------------------- */
+    void               setAiLod(const AiLodPolicy& p) { ai.setPolicy(p); }
+    const AiLodPolicy& aiLod() const                  { return ai.policy(); }
+    // think() calls in the last tick (update() of non-LOD entities not counted)
+    size_t             aiThinksLastTick() const       { return thinksThisTick; }
+
+    /* threading ---------------------------------------------------------- */
+    // n = total threads (caller included); 1 = single-threaded debug mode,
+    // 0 = one per hardware thread. Results do not depend on n.
+    void     setThreadCount(unsigned n) { jobs.setThreadCount(n); }
+    unsigned threadCount() const        { return jobs.threadCount(); }
+
+    /* fixed timestep ---------------------------------------------------- */
+    // The simulation always advances in ticks of 1/tickRate seconds. A slow
+    // frame runs several ticks (at most maxSubsteps, the rest of the backlog
+    // is dropped), a fast one may run none and only re-interpolate.
+    void  setTickRate(float hz)     { fixedDt = 1.0f / std::max(hz, 1.0f); accumulator = 0.0f; }
+    float tickRate() const          { return 1.0f / fixedDt; }
+    float tickDt() const            { return fixedDt; }
+    void  setMaxSubsteps(int n)     { maxSubsteps = std::max(n, 1); }
+    int   ticksLastFrame() const    { return ticksThisFrame; }
+    float interpolationAlpha() const { return alpha; }  // 0 = previous tick, 1 = latest
+
     /* per-frame --------------------------------------------------------- */
-    void update(float dt)
+    // frameDt = wall time since the last frame (GetFrameTime()).
+    // `input` is captured once per frame by the caller (InputState::Capture);
+    // every tick of the frame sees the same snapshot.
+    void update(float frameDt, const InputState& input)
     {
-        // First pass: let each entity run its own logic & keep it in its cell
-        for (auto& ePtr : entities)
-        {
-            Entity& E = *ePtr;
-            if (!E.isAliveAndCollidable()) continue;
-    
-            // Remember old cell & bbox
-            Cell      oldCell = bucketOf(E.getPosition());
-            Rectangle oldBox  = E.getOverallAABB();
-    
-            // Actually update the entity (movement, AI, shape.updateWorldVertices, etc.)
-            E.update(dt, camera);
-    
-            // Keep it inside the world bounds (if you like)
-            keepInside(oldBox, E.getMutablePosition());
-    
-            // If it moved to a new cell, update the grid
-            Cell newCell = bucketOf(E.getPosition());
-            if (oldCell != newCell) {
-                grid.remove(&E, oldBox);
-                grid.insert(&E, E.getOverallAABB());
-            }
+        PROFILE_ZONE("World::update");
+        cam.handleInput(input); // once per frame, not once per tick
 
-            zoomControl(); // Handle zoom control here
-        }
-    
-        // Second pass: broad‐phase via grid + narrow‐phase SAT collisions
-        for (auto& ePtr : entities)
+        accumulator += std::max(frameDt, 0.0f);
+        ticksThisFrame = 0;
+        while (accumulator >= fixedDt && ticksThisFrame < maxSubsteps)
         {
-            Entity& A = *ePtr;
-            if (!A.isAliveAndCollidable()) continue;
+            step(fixedDt, input);
+            accumulator -= fixedDt;
+            ++ticksThisFrame;
+        }
+        // spiral-of-death guard: never carry more than one tick over
+        if (accumulator >= fixedDt) accumulator = std::fmod(accumulator, fixedDt);
 
-            // grab A’s rough AABB and collect all possible B’s
-            Rectangle aabbA = A.getOverallAABB();
-            std::vector<Entity*> candidates;
-            grid.query(aabbA, [&](Entity& e){ candidates.push_back(&e); });
+        endFrame();
 
-            // Now do your narrow‐phase on that snapshot
-            for (Entity* B : candidates)
+        // render poses are blended lazily, only for what gets drawn
+        alpha = accumulator / fixedDt;
+        if (Entity* follow = get(cameraFollow)) cam.update(frameDt, xforms.renderPosition(follow->worldIndex, alpha), input.screenSize);
+        else                                    cam.update(frameDt, input.screenSize);
+    }
+
+    // The end of update(): sweeps the dead and re-packs the grid. Drivers
+    // that call step() themselves (bench, replays) call it once per frame.
+    void endFrame()
+    {
+        if (recorder) recorder->frameEnd();
+        sweepDead();
+        // resolution (and the sweep) moved grid entries after the tick's
+        // rebuild: re-pack once so draw() and gameplay queries see them
+        if (steppedSinceRebuild || sweptThisFrame > 0) grid.rebuild();
+        steppedSinceRebuild = false;
+    }
+
+    /* one simulation tick ------------------------------------------------ */
+    /* Phases:
+         1. entity logic          – parallel chunks, each entity touches only itself
+         2. grid merge            – serial: the grid is not thread-safe
+         3. narrow-phase SAT      – parallel over the pair list, results per pair
+         4. resolution            – serial, in pair order → deterministic
+       Every pair is tested against the same post-update snapshot, so the
+       outcome is identical for any thread count. */
+    // Nothing in here reads raylib's global state. AI LOD distances are
+    // taken from `lodView`: the camera view as of the last frame unless
+    // given (a replay passes the recorded one).
+    void step(float dt, const InputState& input) { step(dt, input, cam.view()); }
+    void step(float dt, const InputState& input, const Rectangle& lodView)
+    {
+        PROFILE_ZONE("World::step");
+        using Clock = std::chrono::steady_clock;
+        // seconds since the previous lap; also a profiler zone `name`
+        auto lap = [last = Clock::now()](const char* name) mutable {
+            const auto now = Clock::now();
+            const double s = std::chrono::duration<double>(now - last).count();
+            PROFILE_SPAN(name, last, now);
+            (void)name;
+            last = now;
+            return s;
+        };
+        StepTimings& t = timings;
+
+        // the pose to interpolate from: one array copy, no object touched
+        xforms.savePrevious();
+        if (recorder) recorder->tick(input, lodView);
+        ai.beginTick(lodView);
+        std::atomic<size_t> thinks{0};
+
+        // Phase 1: let each entity run its own logic & stay inside the world
+        jobs.parallelFor(xforms.size(), UPDATE_GRAIN, [&](size_t begin, size_t end)
+        {
+            size_t chunkThinks = 0;
+            for (size_t i = begin; i < end; ++i)
             {
-                if (B == &A) continue;
-                if (!B->isAliveAndCollidable()) continue;
-                // only do each pair once
-                if (&A > B) continue;
+                Entity& E = *xforms.owner[i];
+                if (!E.isAliveAndCollidable()) continue;
+
+                // Remember old bbox
+                Rectangle oldBox = xforms.aabb[i];
 
-                Vector2 mtv;
-                if (CollisionSystem::CheckShapesCollide(A.shape, B->shape, mtv))
+                // Actually update the entity (movement, AI, shape.updateWorldVertices, etc.)
+                if (E.aiLod)
                 {
-                    // resolve collision by moving both out by half the MTV
-                    Vector2 half = Vector2Scale(mtv, 0.5f);
-                    A.setPosition(Vector2Subtract(A.getPosition(), half));
-                    B->setPosition(Vector2Add   (B->getPosition(), half));
-
-                    // now update the grid entries *after* you’re done querying
-                    grid.remove(&A, aabbA);
-                    grid.insert(&A, A.getOverallAABB());
+                    // far away: decide every few ticks, extrapolate in between
+                    E.thinkDebt += dt;
+                    if (ai.due(E.worldHandle.index, ai.strideFor(oldBox)))
+                    {
+                        E.think(E.thinkDebt, input);
+                        E.thinkDebt = 0.0f;
+                        ++chunkThinks;
+                    }
+                    E.coast(dt);
                 }
+                else E.update(dt, input);
+
+                // Keep it inside the world bounds (if you like)
+                keepInside(oldBox, E.getMutablePosition());
+                E.recalcOverallAABB();   // free unless update()/clamping moved it
+                storeRow(i, E);          // still in cache
+            }
+            thinks.fetch_add(chunkThinks, std::memory_order_relaxed);
+        });
+        thinksThisTick = thinks.load(std::memory_order_relaxed);
+        PROFILE_COUNT("ai thinks", thinksThisTick);
+        t.update = lap("step: update");
+
+        // Phase 2: tell the grid where everybody is now, then pair them up
+        syncGrid();
+        grid.rebuild();   // FlatGrid: re-pack cells once per frame
+        t.grid = lap("step: grid");
+        grid.collectPairs(pairs);
+        t.broadphase = lap("step: broadphase");
+        PROFILE_COUNT("pairs", pairs.size());
+
+        // Phase 3: narrow-phase SAT, one result slot per pair
+        contacts.resize(pairs.size());
+        jobs.parallelFor(pairs.size(), PAIR_GRAIN, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Entity& A = *pairs[i].a;
+                Entity& B = *pairs[i].b;
+                contacts[i] = {};
+                if (!A.isAliveAndCollidable() || !B.isAliveAndCollidable()) continue;
+                CollisionSystem::CheckShapesCollide(A.collider(), B.collider(), contacts[i]);
             }
+        });
+        t.narrowphase = lap("step: narrowphase");
+
+        // Phase 4: apply corrections in pair order
+        for (size_t i = 0; i < pairs.size(); ++i)
+        {
+            const ContactManifold& contact = contacts[i];
+            if (contact.contacts == 0) continue;
+
+            Entity& A = *pairs[i].a;
+            Entity& B = *pairs[i].b;
+
+            // resolve collision by moving both out by half the deepest penetration
+            Vector2 half = Vector2Scale(contact.normal, contact.depth * 0.5f);
+            A.setPosition(Vector2Subtract(A.getPosition(), half));
+            B.setPosition(Vector2Add     (B.getPosition(), half));
+
+            A.onCollision(B);
+            B.onCollision(A);
         }
-    
-        if (cameraFollow) camera.target = cameraFollow->getPosition();
-        clampCamera();
+
+        // resolution moved things around → re-transform (parallel), re-grid (serial)
+        jobs.parallelFor(xforms.size(), UPDATE_GRAIN, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Entity& E = *xforms.owner[i];
+                E.recalcOverallAABB();
+                storeRow(i, E);
+            }
+        });
+        t.resolve = lap("step: resolve");
+        syncGrid();
+        steppedSinceRebuild = true;   // for endFrame(), however step() was driven
+        t.grid += lap("step: grid");
+
+        ++tickCount;
+        if (recorder) recorder->tickDone(stateHash());
     }
 
-    void draw()
+    // phase times of the most recent step()
+    const StepTimings& lastStepTimings() const { return timings; }
+    // step() calls so far
+    uint64_t tickIndex() const { return tickCount; }
+
+    /* determinism -------------------------------------------------------- */
+    // Logs spawns, inputs and per-tick hashes into `r` (replay.hpp) from
+    // now on; nullptr stops. Only before the first tick – what has run
+    // already (rng draws, think phases) is not in a log. Entities that
+    // exist are logged as spawned where they stand, in handle order.
+    bool record(ReplayRecorder* r)
     {
-        BeginMode2D(camera);
-            drawBackground();
+        if (r && tickCount > 0) return false;
+        recorder = r;
+        if (!r) return true;
+        r->begin(seed, fixedDt, GridT::NAME, jobs.threadCount());
+        std::vector<Entity*> existing(xforms.owner.begin(), xforms.owner.end());
+        std::sort(existing.begin(), existing.end(),
+                  [](const Entity* a, const Entity* b) { return a->handle().index < b->handle().index; });
+        for (Entity* e : existing) r->spawned(*e, e->getPosition());
+        return true;
+    }
+    ReplayRecorder* recording() const { return recorder; }
 
-            Rectangle view = expandedView(64);   // small margin
-            grid.query(view, [&](Entity& e){ e.draw(camera); });
-        EndMode2D();
+    // FNV-1a over every row's handle, position, rotation and velocity, in
+    // row order, by bit pattern: equal hashes = the same world, exactly
+    uint64_t stateHash() const
+    {
+        uint64_t h = 0xcbf29ce484222325ull;
+        auto mix = [&h](uint32_t v) {
+            for (int i = 0; i < 4; ++i) { h ^= (v >> (8 * i)) & 0xffu; h *= 0x100000001b3ull; }
+        };
+        auto mixf = [&mix](float f) { uint32_t b; std::memcpy(&b, &f, sizeof b); mix(b); };
+        mix(uint32_t(xforms.size()));
+        for (size_t i = 0; i < xforms.size(); ++i)
+        {
+            const Entity& e = *xforms.owner[i];
+            mix(e.handle().index);
+            mixf(e.getPosition().x); mixf(e.getPosition().y);
+            mixf(e.rotation);
+            mixf(e.velocity.x); mixf(e.velocity.y);
+        }
+        return h;
     }
 
-    void zoomControl()
+    /* rendering --------------------------------------------------------- */
+    // Visible entities submit into one queue, which is sorted by layer and
+    // texture and drawn in a single pass. Debug outlines go on top.
+    void draw()
     {
-        float wheel = GetMouseWheelMove();
-        if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL))
+        PROFILE_ZONE("World::draw");
+        const Rectangle view = cam.view(64);   // small on-screen margin
+        collectVisible(view);
+        renderQueue.clear();
+        background.update(view, cam.camera().target);
+        background.submit(renderQueue);          // below every entity layer
+        for (uint32_t i : visible)
         {
-            if (wheel > 0) targetZoom = std::min(targetZoom + 0.2f, 3.0f);
-            else if (wheel < 0) targetZoom = std::max(targetZoom - 0.2f, 0.5f);
+            Entity& e = *xforms.owner[i];
+            e.setRenderPose(xforms.renderPosition(i, alpha), xforms.renderRotation(i, alpha));
+            const Vector2 before = e.size;
+            e.pollTexture();
+            if (recorder && (e.size.x != before.x || e.size.y != before.y)) recorder->resized(e.handle(), e.size);
+            e.submit(renderQueue);
         }
+
+        {
+            PROFILE_ZONE("draw: flush");
+            BeginMode2D(cam.camera());
+                renderQueue.flush();
+                if (debugDraw) for (uint32_t i : visible) xforms.owner[i]->drawDebug();
+            EndMode2D();
+        }
+        PROFILE_VALUE("draw calls",   renderQueue.stats().draws);
+        PROFILE_VALUE("batch breaks", renderQueue.stats().batchBreaks);
+        PROFILE_VALUE("visible",      visible.size());
+
+        if (debugDraw) drawStats();
+        if (profilerOverlay) Profile().drawOverlay(GetScreenWidth() - 640, 10);
     }
 
+    /* visibility of the last draw() ------------------------------------- */
+    // rows (Entity::worldIndex) that were drawn, each once, in grid order
+    const std::vector<uint32_t>& visibleRows() const { return visible; }
+    size_t visibleCount() const { return visible.size(); }
+    size_t culledCount() const  { return visibleOf - visible.size(); }
+
+    void setDebugDraw(bool on) { debugDraw = on; }
+    bool debugDrawEnabled() const { return debugDraw; }
+    // Profile() zones / counters, top right; frame() is up to the caller
+    void setProfilerOverlay(bool on) { profilerOverlay = on; }
+    bool profilerOverlayEnabled() const { return profilerOverlay; }
+    const RenderQueue::Stats& renderStats() const { return renderQueue.stats(); }
+
+    /* background layers (the constructor adds the full-world backdrop) -- */
+    TiledBackground&       backgroundLayers()       { return background; }
+    const TiledBackground& backgroundLayers() const { return background; }
+
+    /* camera: zoom target / limits, view ------------------------------- */
+    CameraController&       cameraController()       { return cam; }
+    const CameraController& cameraController() const { return cam; }
+
     /* teleport-safe ----------------------------------------------------- */
     void teleport(Entity& e, Vector2 newPos)
     {
-        grid.remove(&e, e.getCollision());
+        if (recorder) recorder->teleported(e.handle(), newPos);
         e.setPosition(newPos);
-        grid.insert(&e, e.getCollision());
+        e.recalcOverallAABB();
+        storeRow(e.worldIndex, e);
+        xforms.setPrevious(e.worldIndex, e.getPosition(), e.rotation);   // no smear across the jump
+        e.setRenderPose(e.getPosition(), e.rotation);
+        syncGrid(e.worldIndex);
     }
 
     /* expose camera (read-only) ---------------------------------------- */
-    const Camera2D& getCamera() const { return camera; }
+    const Camera2D& getCamera() const { return cam.camera(); }
+
+    /* broad-phase pairs of the last update (read-only) ------------------ */
+    // Every pair whose AABBs overlap, each listed once. Valid until the
+    // next update(); gameplay code can walk it instead of re-querying.
+    const std::vector<EntityPair>& potentialPairs() const { return pairs; }
+    // SAT result for potentialPairs()[i]; contacts == 0 means no hit.
+    const std::vector<ContactManifold>& pairContacts() const { return contacts; }
+
+    /* pooled world geometry of every spawned shape (read-only) ---------- */
+    const ShapePool& shapePool() const { return shapes; }
+
+    /* spatial queries ---------------------------------------------------- */
+    /* Main thread, outside step(): they read the grid as of the last
+       update() and the current AABB rows. Each entity is looked at once
+       per query, however many cells it spans; nothing is allocated once
+       the `out` vectors have grown. `accept(const Entity&)` filters (team,
+       self, …) and only sees candidates that passed the geometric test. */
+
+    // First shape hit by origin + t·dir, t in [0, maxDist]. Cells are walked
+    // in ray order (DDA); the walk stops as soon as the best hit is nearer
+    // than the far edge of the current cell.
+    template<typename Pred = AnyEntity>
+    RayHit raycast(Vector2 origin, Vector2 dir, float maxDist, Pred&& accept = {}) const
+    {
+        PROFILE_ZONE_DETAIL("World::raycast");
+        RayHit hit;
+        const float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+        if (len <= 0.0f || !(maxDist > 0.0f)) return hit;
+        const Vector2 d { dir.x / len, dir.y / len };
+
+        float t0 = 0.0f, t1 = maxDist;
+        if (!RayAABB(origin, d, { 0, 0, float(WORLD_W), float(WORLD_H) }, t0, t1)) return hit;
+        beginQuery();
+
+        // Amanatides–Woo: t at the next vertical / horizontal cell boundary
+        const float cs  = float(CELL_SIZE);
+        const float inf = std::numeric_limits<float>::infinity();
+        int cx = cellOf(origin.x + d.x * t0, GRID_COLS);
+        int cy = cellOf(origin.y + d.y * t0, GRID_ROWS);
+        const int   stepX  = d.x > 0 ? 1 : (d.x < 0 ? -1 : 0);
+        const int   stepY  = d.y > 0 ? 1 : (d.y < 0 ? -1 : 0);
+        const float deltaX = stepX ? cs / std::fabs(d.x) : inf;
+        const float deltaY = stepY ? cs / std::fabs(d.y) : inf;
+        float nextX = stepX ? ((cx + (stepX > 0)) * cs - origin.x) / d.x : inf;
+        float nextY = stepY ? ((cy + (stepY > 0)) * cs - origin.y) / d.y : inf;
+
+        float best = t1;
+        for (;;)
+        {
+            grid.queryCell(cx, cy, [&](Entity& e) {
+                const uint32_t i = e.worldIndex;
+                if (!firstVisit(i) || !e.alive() || !e.collidable()) return;
+                float lo = 0.0f, hi = best;
+                if (!RayAABB(origin, d, xforms.aabb[i], lo, hi) || !accept(static_cast<const Entity&>(e))) return;
+
+                float t; Vector2 n;
+                if (!CollisionSystem::RaycastShape(e.collider(), origin, d, best, t, n)) return;
+                if (hit && t >= best) return;
+                best = t;
+                hit  = { &e, t, { origin.x + d.x * t, origin.y + d.y * t }, n };
+            });
+
+            const float cellExit = std::min(nextX, nextY);
+            if ((hit && best <= cellExit) || cellExit > t1) break;
+            if (nextX < nextY) { cx += stepX; nextX += deltaX; }
+            else               { cy += stepY; nextY += deltaY; }
+            if (cx < 0 || cx >= GRID_COLS || cy < 0 || cy >= GRID_ROWS) break;
+        }
+        return hit;
+    }
+
+    // Every live entity whose AABB touches the circle, in grid order.
+    // Cells outside the circle are skipped. Returns out.size().
+    template<typename Pred = AnyEntity>
+    size_t queryRadius(Vector2 center, float radius, std::vector<Entity*>& out, Pred&& accept = {}) const
+    {
+        out.clear();
+        if (!(radius >= 0.0f)) return 0;
+        beginQuery();
+        const float r2 = radius * radius;
+        const int x0 = cellOf(center.x - radius, GRID_COLS), x1 = cellOf(center.x + radius, GRID_COLS);
+        const int y0 = cellOf(center.y - radius, GRID_ROWS), y1 = cellOf(center.y + radius, GRID_ROWS);
+        for (int cy = y0; cy <= y1; ++cy)
+            for (int cx = x0; cx <= x1; ++cx)
+            {
+                if (DistanceSqToAABB(center, cellRect(cx, cy)) > r2) continue;   // a corner the circle misses
+                grid.queryCell(cx, cy, [&](Entity& e) {
+                    const uint32_t i = e.worldIndex;
+                    if (!firstVisit(i) || !e.alive() || DistanceSqToAABB(center, xforms.aabb[i]) > r2) return;
+                    if (accept(static_cast<const Entity&>(e))) out.push_back(&e);
+                });
+            }
+        return out.size();
+    }
+
+    // Up to k live entities nearest to `p` (distance to their AABB) within
+    // maxDist, nearest first. Rings of cells around p are searched outwards
+    // until nothing unseen can beat the k-th best. Returns out.size().
+    template<typename Pred = AnyEntity>
+    size_t nearest(Vector2 p, size_t k, std::vector<Neighbour>& out,
+                   float maxDist = std::numeric_limits<float>::infinity(), Pred&& accept = {}) const
+    {
+        out.resize(k);   // the heap lives in `out`: no allocation once it has grown
+        out.resize(nearestInto(p, k, out.data(), maxDist, accept));
+        return out.size();
+    }
+
+    // the single nearest match, or nullptr
+    template<typename Pred = AnyEntity>
+    Entity* nearestOne(Vector2 p, float maxDist = std::numeric_limits<float>::infinity(), Pred&& accept = {}) const
+    {
+        Neighbour best;
+        return nearestInto(p, 1, &best, maxDist, accept) ? best.entity : nullptr;
+    }
 
 private:
-    /* helper struct for quick bucket compare --------------------------- */
-    struct Cell { int x, y; bool operator!=(const Cell& o) const { return x!=o.x || y!=o.y; } };
+    template<typename T>
+    ObjectPool<T>& poolFor()
+    {
+        auto& slot = pools[std::type_index(typeid(T))];
+        if (!slot) slot = std::make_unique<ObjectPool<T>>();
+        return static_cast<ObjectPool<T>&>(*slot);
+    }
+
+    /* end of frame: reclaim everything that died ------------------------ */
+    void sweepDead()
+    {
+        sweptThisFrame = 0;
+        auto dead = [](const Entity* e) { return !e->alive(); };
+        if (std::none_of(xforms.owner.begin(), xforms.owner.end(), dead)) return;
+
+        // the last tick's pair list must not outlive its entities
+        size_t keep = 0;
+        for (size_t i = 0; i < pairs.size(); ++i)
+        {
+            if (dead(pairs[i].a) || dead(pairs[i].b)) continue;
+            pairs[keep]    = pairs[i];
+            contacts[keep] = contacts[i];
+            ++keep;
+        }
+        pairs.resize(keep);
+        contacts.resize(keep);
 
-    Cell bucketOf(Vector2 p) const { return { int(p.x) / CELL_SIZE, int(p.y) / CELL_SIZE }; }
+        for (size_t i = 0; i < xforms.size(); )
+        {
+            Entity* e = xforms.owner[i];
+            if (!dead(e)) { ++i; continue; }
+
+            grid.remove(e, xforms.grid[i]);
+            e->detachShapePool();
+            PoolBase* pool = registry.poolOf(e->handle());
+            registry.remove(e->handle());
+            // swap-and-pop: order stays deterministic
+            if (Entity* moved = xforms.swapRemove(i)) moved->worldIndex = uint32_t(i);
+            pool->destroy(e);
+            ++sweptThisFrame;
+        }
+    }
 
-    Rectangle expandedView(float margin) const
+    /* copy an entity's pose + bounds into its SoA row ------------------- */
+    void storeRow(size_t i, const Entity& e)
     {
-        return { camera.target.x - GetScreenWidth()*0.5f - margin,
-                 camera.target.y - GetScreenHeight()*0.5f - margin,
-                 (float)GetScreenWidth()  + margin*2,
-                 (float)GetScreenHeight() + margin*2 };
+        xforms.setPose(i, e.getPosition(), e.rotation);
+        xforms.aabb[i] = e.getOverallAABB();
     }
 
-    void clampCamera()
+    /* keep the grid entries in step with the current AABBs -------------- */
+    // streams the two box arrays; only rows that moved reach the grid
+    void syncGrid()
+    {
+        for (size_t i = 0; i < xforms.size(); ++i) syncGrid(i);
+    }
+    void syncGrid(size_t i)
     {
-        float halfW = GetScreenWidth()*0.5f;
-        float halfH = GetScreenHeight()*0.5f;
-        camera.target.x = std::clamp(camera.target.x, halfW, WORLD_W - halfW);
-        camera.target.y = std::clamp(camera.target.y, halfH, WORLD_H - halfH);
+        if (xforms.gridBoxCurrent(i)) return;
+        grid.update(xforms.owner[i], xforms.grid[i], xforms.aabb[i]);
+        xforms.grid[i] = xforms.aabb[i];
     }
 
-    /* background -------------------------------------------------------- */
-    void drawBackground() const
+    /* spatial query helpers ----------------------------------------------- */
+    static int cellOf(float v, int n) { return std::clamp(int(std::floor(v / CELL_SIZE)), 0, n - 1); }
+    static Rectangle cellRect(int cx, int cy)
     {
-        Rectangle src { 0, 0, (float)backgroundTex.width,  (float)backgroundTex.height };
-        Rectangle dst { 0, 0, (float)backgroundTex.width,  (float)backgroundTex.height };
-        DrawTexturePro(backgroundTex, src, dst, {0,0}, 0.0f, WHITE);
+        return { float(cx * CELL_SIZE), float(cy * CELL_SIZE), float(CELL_SIZE), float(CELL_SIZE) };
+    }
+
+    // per-query dedup stamps, like the visibility pass
+    void beginQuery() const
+    {
+        queryStamp.resize(xforms.size(), 0u);
+        if (++queryPass == 0) {
+            std::fill(queryStamp.begin(), queryStamp.end(), 0u);
+            queryPass = 1;
+        }
+    }
+    bool firstVisit(uint32_t row) const
+    {
+        if (queryStamp[row] == queryPass) return false;
+        queryStamp[row] = queryPass;
+        return true;
+    }
+
+    // k-nearest into heap[0..k), a max-heap on distance while searching;
+    // sorted nearest first on return
+    template<typename Pred>
+    size_t nearestInto(Vector2 p, size_t k, Neighbour* heap, float maxDist, Pred& accept) const
+    {
+        if (k == 0 || !(maxDist >= 0.0f)) return 0;
+        beginQuery();
+        // "a is nearer" – as the heap order that keeps the farthest at heap[0];
+        // ties broken by row, so the result never depends on visit order
+        auto nearer = [](const Neighbour& a, const Neighbour& b) {
+            return a.distSq != b.distSq ? a.distSq < b.distSq : a.entity->worldIndex < b.entity->worldIndex;
+        };
+        const float maxSq = maxDist * maxDist;
+        size_t n = 0;
+        auto limit = [&] { return n == k ? heap[0].distSq : maxSq; };
+
+        auto visit = [&](int cx, int cy) {
+            if (DistanceSqToAABB(p, cellRect(cx, cy)) > limit()) return;
+            grid.queryCell(cx, cy, [&](Entity& e) {
+                const uint32_t i = e.worldIndex;
+                if (!firstVisit(i) || !e.alive()) return;
+                const Neighbour cand { &e, DistanceSqToAABB(p, xforms.aabb[i]) };
+                if (cand.distSq > maxSq || (n == k && !nearer(cand, heap[0]))) return;
+                if (!accept(static_cast<const Entity&>(e))) return;
+                if (n == k) std::pop_heap(heap, heap + n--, nearer);
+                heap[n++] = cand;
+                std::push_heap(heap, heap + n, nearer);
+            });
+        };
+
+        const int ccx = cellOf(p.x, GRID_COLS), ccy = cellOf(p.y, GRID_ROWS);
+        const float cs = float(CELL_SIZE);
+        for (int r = 0; ; ++r)
+        {
+            // ring r: the border of the (2r+1)² block of cells around p's cell
+            const int x0 = ccx - r, x1 = ccx + r, y0 = ccy - r, y1 = ccy + r;
+            for (int x = std::max(x0, 0); x <= std::min(x1, GRID_COLS - 1); ++x) {
+                if (y0 >= 0)                 visit(x, y0);
+                if (y1 < GRID_ROWS && r > 0) visit(x, y1);
+            }
+            for (int y = std::max(y0 + 1, 0); y <= std::min(y1 - 1, GRID_ROWS - 1); ++y) {
+                if (x0 >= 0)                 visit(x0, y);
+                if (x1 < GRID_COLS && r > 0) visit(x1, y);
+            }
+
+            if (x0 <= 0 && y0 <= 0 && x1 >= GRID_COLS - 1 && y1 >= GRID_ROWS - 1) break;   // whole grid seen
+            // anything not seen yet lies outside the block: at least `edge` away
+            const float edge = std::min({ p.x - x0 * cs, (x1 + 1) * cs - p.x, p.y - y0 * cs, (y1 + 1) * cs - p.y });
+            if (edge > 0.0f && edge * edge > limit()) break;
+        }
+        std::sort_heap(heap, heap + n, nearer);
+        return n;
+    }
+
+    /* visibility pass: every entity whose bounds touch `view`, once ----- */
+    // The grid hands back whole cells – UniformGrid even repeats entities
+    // that span several – so rows are stamped per pass and the AABB is
+    // tested against the exact view before a row is kept.
+    void collectVisible(const Rectangle& view)
+    {
+        visible.clear();
+        visibleOf = xforms.size();
+        visStamp.resize(xforms.size(), 0u);
+        if (++visPass == 0) {                    // stamp wrapped: reset once
+            std::fill(visStamp.begin(), visStamp.end(), 0u);
+            visPass = 1;
+        }
+        grid.query(view, [&](Entity& e){
+            const uint32_t i = e.worldIndex;
+            if (visStamp[i] == visPass) return;
+            visStamp[i] = visPass;
+            if (AABBOverlap(xforms.aabb[i], view)) visible.push_back(i);
+        });
+    }
+
+    void drawStats() const
+    {
+        const RenderQueue::Stats& s = renderQueue.stats();
+        DrawText(TextFormat("draws %d  batch breaks %d  textures %d  ticks %d  entities %d",
+                            (int)s.draws, (int)s.batchBreaks, (int)s.textures, ticksThisFrame, (int)xforms.size()),
+                 10, 10, 20, RAYWHITE);
+        DrawText(Assets().describe().c_str(), 10, 34, 20, RAYWHITE);
+        DrawText(TextFormat("shapes %d  pool %d KB", (int)shapes.liveCount(), (int)(shapes.bytesInUse() / 1024)),
+                 10, 58, 20, RAYWHITE);
+        DrawText(TextFormat("visible %d  culled %d  zoom %.2f", (int)visibleCount(), (int)culledCount(), cam.zoom()),
+                 10, 82, 20, RAYWHITE);
+        DrawText(TextFormat("ai thinks %d / tick", (int)thinksThisTick), 10, 106, 20, RAYWHITE);
+        const TiledBackground::Stats bg = background.stats();
+        DrawText(TextFormat("bg layers %d  tiles drawn %d  resident %d  loading %d",
+                            (int)bg.layers, (int)bg.drawn, (int)bg.resident, (int)bg.loading),
+                 10, 130, 20, RAYWHITE);
     }
 
     /* data -------------------------------------------------------------- */
-    UniformGrid                                       grid;
-    std::vector<std::unique_ptr<Entity>>              entities;
-    Camera2D                                          camera;
-    Entity* cameraFollow = nullptr;
-    Texture2D                                         backgroundTex{};  
-    float   targetZoom     = 1.0f;      // where we want to go
-    float   zoomSmoothSpeed = 8.0f;     // the larger, the snappier
+    ShapePool                                         shapes;    // world vertices, indexed by entity slot
+    GridT                                             grid;
+    std::vector<EntityPair>                           pairs;     // reused every frame
+    std::vector<ContactManifold>                      contacts;  // one per pair, reused
+    JobSystem                                         jobs;      // hardware threads by default
+    AiScheduler                                       ai;        // think() rate per entity
+    size_t                                            thinksThisTick = 0;
+    StepTimings                                       timings;   // of the last step()
+    uint64_t                                          seed = DEFAULT_SEED;
+    uint64_t                                          tickCount = 0;
+    ReplayRecorder*                                   recorder = nullptr;  // World::record()
+    RenderQueue                                       renderQueue; // reused every frame
+    bool                                              debugDraw = false;
+    bool                                              profilerOverlay = false;
+    std::unordered_map<std::type_index, std::unique_ptr<PoolBase>> pools;  // one per entity class
+    EntityRegistry                                    registry;  // handles → entities
+    EntityTransforms                                  xforms;    // live entities (owner[]) + their SoA rows
+    size_t                                            sweptThisFrame = 0;
+    bool                                              steppedSinceRebuild = false;
+    std::vector<uint32_t>                             visible;   // rows drawn by the last draw()
+    std::vector<uint32_t>                             visStamp;  // per row: last pass that saw it
+    uint32_t                                          visPass  = 0;
+    size_t                                            visibleOf = 0;  // entity count at that pass
+    mutable std::vector<uint32_t>                     queryStamp;  // per row: last spatial query that saw it
+    mutable uint32_t                                  queryPass = 0;
+    CameraController                                  cam;       // zoom, clamping, view rect
+    EntityHandle                                      cameraFollow;
+    TiledBackground                                   background; // parallax layers, streamed around the view
+    float   fixedDt        = 1.0f / DEFAULT_TICK_RATE;
+    int     maxSubsteps    = DEFAULT_MAX_STEPS;
+    float   accumulator    = 0.0f;      // unsimulated wall time
+    float   alpha          = 1.0f;      // render blend for this frame
+    int     ticksThisFrame = 0;
 };
+
+using World = BasicWorld<UniformGrid>;
 /* ───────────────────────────────────────────────────────────────────── */
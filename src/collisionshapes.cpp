@@ -1,13 +1,20 @@
 #include "collisionshapes.hpp"
+#include "profiler.hpp"
 #include <raymath.h>
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <sstream>
 #include <cmath> //
 
 // --- ConvexPolygon Implementation ---
 
-ConvexPolygon::ConvexPolygon(const std::vector<Vector2>& vertices) : localVertices(vertices) {
+ConvexPolygon::ConvexPolygon(const std::vector<Vector2>& vertices) {
+    setLocalVertices(vertices);
+}
+
+void ConvexPolygon::setLocalVertices(const std::vector<Vector2>& vertices) {
+    localVertices = vertices;
     worldVertices.resize(localVertices.size());
     if (!localVertices.empty()) {
         localCenter = {0,0};
@@ -19,6 +26,24 @@ ConvexPolygon::ConvexPolygon(const std::vector<Vector2>& vertices) : localVertic
         localCenter = {0,0};
     }
     worldCenter = localCenter; // Initially same, will be transformed
+    localSoA.assign(localVertices);
+    worldSoA = localSoA;
+
+    // Unique edge normals, once. Same dedup rule as GetUniqueAxes, but
+    // zero-length edges are skipped instead of producing a {0,0} axis.
+    localNormals.clear();
+    for (size_t i = 0; localVertices.size() >= 2 && i < localVertices.size(); ++i) {
+        Vector2 edge = Vector2Subtract(localVertices[(i + 1) % localVertices.size()], localVertices[i]);
+        if (Vector2LengthSqr(edge) < 1e-12f) continue;
+        Vector2 normal = Vector2Normalize({-edge.y, edge.x});
+
+        bool foundParallel = false;
+        for (const auto& existing : localNormals) {
+            if (fabsf(Vector2DotProduct(normal, existing)) > 0.999f) { foundParallel = true; break; }
+        }
+        if (!foundParallel) localNormals.push_back(normal);
+    }
+    worldNormals = localNormals;
 }
 
 void ConvexPolygon::transform(Vector2 entityPosition, float entityRotationDegrees, float entityScale) {
@@ -28,21 +53,49 @@ void ConvexPolygon::transform(Vector2 entityPosition, float entityRotationDegree
     float cosTheta = cosf(rotationRadians);
     float sinTheta = sinf(rotationRadians);
 
-    for (size_t i = 0; i < localVertices.size(); ++i) {
-        Vector2 v = localVertices[i];
+    if (localSoA.count == localVertices.size() && worldSoA.padded() == localSoA.padded()) {
+        // SIMD path: transform the padded SoA copy, then mirror it to AoS
+        simd::TransformPoints(localSoA.x.data(), localSoA.y.data(),
+                              worldSoA.x.data(), worldSoA.y.data(), localSoA.padded(),
+                              cosTheta, sinTheta, entityScale, entityPosition.x, entityPosition.y);
+        for (size_t i = 0; i < localVertices.size(); ++i) {
+            worldVertices[i] = { worldSoA.x[i], worldSoA.y[i] };
+        }
+    } else {
+        for (size_t i = 0; i < localVertices.size(); ++i) {
+            Vector2 v = localVertices[i];
+
+            // Scale (around local origin {0,0} which is the pivot)
+            v.x *= entityScale;
+            v.y *= entityScale;
 
-        // Scale (around local origin {0,0} which is the pivot)
-        v.x *= entityScale;
-        v.y *= entityScale;
+            // Rotate (around local origin {0,0} which is the pivot)
+            float rotatedX = v.x * cosTheta - v.y * sinTheta;
+            float rotatedY = v.x * sinTheta + v.y * cosTheta;
+            v = {rotatedX, rotatedY};
 
-        // Rotate (around local origin {0,0} which is the pivot)
-        float rotatedX = v.x * cosTheta - v.y * sinTheta;
-        float rotatedY = v.x * sinTheta + v.y * cosTheta;
-        v = {rotatedX, rotatedY};
+            // Translate to world position
+            worldVertices[i] = Vector2Add(entityPosition, v);
+        }
+    }
 
-        // Translate to world position
-        worldVertices[i] = Vector2Add(entityPosition, v);
+    // Rotate the cached axes (no scale, no renormalisation needed)
+    for (size_t i = 0; i < localNormals.size(); ++i) {
+        const Vector2 n = localNormals[i];
+        worldNormals[i] = { n.x * cosTheta - n.y * sinTheta,
+                            n.x * sinTheta + n.y * cosTheta };
+    }
+
+    // Refresh the cached bounds while the vertices are hot
+    float minX = worldVertices[0].x, maxX = minX;
+    float minY = worldVertices[0].y, maxY = minY;
+    for (size_t i = 1; i < worldVertices.size(); ++i) {
+        minX = std::min(minX, worldVertices[i].x);
+        maxX = std::max(maxX, worldVertices[i].x);
+        minY = std::min(minY, worldVertices[i].y);
+        maxY = std::max(maxY, worldVertices[i].y);
     }
+    worldAABB = { minX, minY, maxX - minX, maxY - minY };
 
     // Transform the local center to world space
     Vector2 scaledCenter = Vector2Scale(localCenter, entityScale);
@@ -51,6 +104,22 @@ void ConvexPolygon::transform(Vector2 entityPosition, float entityRotationDegree
     worldCenter = Vector2Add(entityPosition, {rotatedCenterX, rotatedCenterY});
 }
 
+PolygonView ConvexPolygon::view() const {
+    PolygonView v;
+    if (worldSoA.count == worldVertices.size() && worldSoA.count) {
+        v.x = worldSoA.x.data();
+        v.y = worldSoA.y.data();
+        v.padded = worldSoA.padded();
+    }
+    v.aos         = worldVertices.data();
+    v.count       = worldVertices.size();
+    v.normals     = worldNormals.data();
+    v.normalCount = worldNormals.size();
+    v.center      = worldCenter;
+    v.aabb        = worldAABB;
+    return v;
+}
+
 void ConvexPolygon::drawLines(Color color) const {
     if (worldVertices.size() >= 2) {
         for (size_t i = 0; i < worldVertices.size(); ++i) {
@@ -65,32 +134,49 @@ void ConvexPolygon::drawLines(Color color) const {
     // DrawCircleV(worldCenter, 3, BLUE);
 }
 
-Rectangle ConvexPolygon::getAABB() const {
-    if (worldVertices.empty()) return {0,0,0,0};
-    float minX = worldVertices[0].x;
-    float maxX = minX;
-    float minY = worldVertices[0].y;
-    float maxY = minY;
-    for (size_t i = 1; i < worldVertices.size(); ++i) {
-        const auto &v = worldVertices[i];
-        minX = std::min(minX, v.x);
-        maxX = std::max(maxX, v.x);
-        minY = std::min(minY, v.y);
-        maxY = std::max(maxY, v.y);
-    }
-    return { minX, minY, maxX - minX, maxY - minY };
-}
-
 // --- CollisionShape Implementation ---
 
+void ConvexPolygon::setPrecomputed(std::vector<Vector2> vertices, std::vector<Vector2> normals, Vector2 center) {
+    localVertices = std::move(vertices);
+    localNormals  = std::move(normals);
+    localCenter   = center;
+    worldCenter   = center;
+    worldVertices.resize(localVertices.size());
+    worldNormals  = localNormals;
+    localSoA.assign(localVertices);
+    worldSoA = localSoA;
+}
+
 void CollisionShape::addPolygon(const std::vector<Vector2>& adjustedLocalVertices) {
-    polygons.emplace_back(adjustedLocalVertices);
+    if (adjustedLocalVertices.size() < 4 || ShapeDecomposition::IsConvex(adjustedLocalVertices)) {
+        polygons.emplace_back(adjustedLocalVertices);
+        return;
+    }
+    for (auto& piece : ShapeDecomposition::Decompose(adjustedLocalVertices)) {
+        polygons.emplace_back(piece);
+    }
 }
 
 void CollisionShape::updateWorldVertices(Vector2 entityPosition, float entityRotationDegrees, float entityScale) {
+    bool first = true;
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
     for (auto& poly : polygons) {
         poly.transform(entityPosition, entityRotationDegrees, entityScale);
+        if (poly.worldVertices.empty()) continue;
+
+        const Rectangle& b = poly.worldAABB;
+        if (first) {
+            minX = b.x;  maxX = b.x + b.width;
+            minY = b.y;  maxY = b.y + b.height;
+            first = false;
+        } else {
+            minX = std::min(minX, b.x);
+            minY = std::min(minY, b.y);
+            maxX = std::max(maxX, b.x + b.width);
+            maxY = std::max(maxY, b.y + b.height);
+        }
     }
+    worldBounds = { minX, minY, maxX - minX, maxY - minY };
 }
 
 void CollisionShape::drawLines(Color color) const {
@@ -99,6 +185,229 @@ void CollisionShape::drawLines(Color color) const {
     }
 }
 
+// --- ShapeView Implementation ---
+
+ShapeView::ShapeView(const CollisionShape& s) : shape(&s) {}
+
+size_t ShapeView::size() const {
+    return shape ? shape->polygons.size() : pieceCount;
+}
+
+Rectangle ShapeView::worldBounds() const {
+    return shape ? shape->worldBounds : bounds;
+}
+
+PolygonView ShapeView::piece(size_t i) const {
+    if (shape) return shape->polygons[i].view();
+    const PieceInstance& p = pieces[i];
+    PolygonView v;
+    v.x           = x + p.soa;
+    v.y           = y + p.soa;
+    v.padded      = p.padded;
+    v.count       = p.count;
+    v.normals     = normals + p.normal;
+    v.normalCount = p.normalCount;
+    v.center      = p.center;
+    v.aabb        = p.aabb;
+    return v;
+}
+
+void ShapeView::drawLines(Color color) const {
+    if (shape) { shape->drawLines(color); return; }
+    for (size_t i = 0; i < pieceCount; ++i) {
+        const PieceInstance& p = pieces[i];
+        for (uint32_t k = 0; k < p.count; ++k) {
+            const uint32_t a = p.soa + k, b = p.soa + (k + 1) % p.count;
+            DrawLineV({ x[a], y[a] }, { x[b], y[b] }, color);
+        }
+    }
+}
+
+// --- ShapeDecomposition Implementation ---
+namespace ShapeDecomposition {
+
+static float Cross(Vector2 o, Vector2 a, Vector2 b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+float SignedArea(const std::vector<Vector2>& outline) {
+    float area = 0.0f;
+    for (size_t i = 0; i < outline.size(); ++i) {
+        const Vector2& a = outline[i];
+        const Vector2& b = outline[(i + 1) % outline.size()];
+        area += a.x * b.y - b.x * a.y;
+    }
+    return area * 0.5f;
+}
+
+bool IsConvex(const std::vector<Vector2>& outline) {
+    const size_t n = outline.size();
+    if (n < 4) return true;
+    float sign = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        float c = Cross(outline[i], outline[(i + 1) % n], outline[(i + 2) % n]);
+        if (fabsf(c) < 1e-4f) continue;             // collinear, ignore
+        if (sign == 0.0f) sign = c;
+        else if ((c > 0.0f) != (sign > 0.0f)) return false;
+    }
+    return true;
+}
+
+std::vector<Vector2> CleanOutline(const std::vector<Vector2>& outline) {
+    std::vector<Vector2> out;
+    out.reserve(outline.size());
+    for (const auto& v : outline) {
+        if (out.empty() || Vector2DistanceSqr(out.back(), v) > 1e-6f) out.push_back(v);
+    }
+    while (out.size() > 1 && Vector2DistanceSqr(out.front(), out.back()) <= 1e-6f) out.pop_back();
+
+    // drop vertices that sit on the line between their neighbours
+    bool removed = true;
+    while (removed && out.size() > 3) {
+        removed = false;
+        for (size_t i = 0; i < out.size() && out.size() > 3; ++i) {
+            const Vector2& p = out[(i + out.size() - 1) % out.size()];
+            const Vector2& n = out[(i + 1) % out.size()];
+            float len = Vector2Distance(p, out[i]) * Vector2Distance(out[i], n);
+            if (fabsf(Cross(p, out[i], n)) <= 1e-6f * len) {
+                out.erase(out.begin() + i);
+                removed = true;
+            }
+        }
+    }
+
+    if (SignedArea(out) < 0.0f) std::reverse(out.begin(), out.end());
+    return out;
+}
+
+std::vector<Vector2> ConvexHull(std::vector<Vector2> points) {
+    if (points.size() < 3) return points;
+    std::sort(points.begin(), points.end(), [](const Vector2& a, const Vector2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    std::vector<Vector2> hull(points.size() * 2);
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i) {                    // lower
+        while (k >= 2 && Cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0f) --k;
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, t = k + 1; i-- > 0;) {        // upper
+        while (k >= t && Cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0f) --k;
+        hull[k++] = points[i];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+// Point strictly inside (or on the border of) triangle abc, positive winding.
+static bool InTriangle(Vector2 p, Vector2 a, Vector2 b, Vector2 c) {
+    return Cross(a, b, p) >= 0.0f && Cross(b, c, p) >= 0.0f && Cross(c, a, p) >= 0.0f;
+}
+
+// Ear clipping. Returns triangles as index triples into `poly`.
+static bool Triangulate(const std::vector<Vector2>& poly, std::vector<std::vector<int>>& tris) {
+    std::vector<int> ring(poly.size());
+    for (size_t i = 0; i < ring.size(); ++i) ring[i] = int(i);
+
+    size_t guard = 0;
+    while (ring.size() > 3) {
+        bool clipped = false;
+        for (size_t i = 0; i < ring.size(); ++i) {
+            int ip = ring[(i + ring.size() - 1) % ring.size()];
+            int ic = ring[i];
+            int in = ring[(i + 1) % ring.size()];
+            const Vector2 &a = poly[ip], &b = poly[ic], &c = poly[in];
+            if (Cross(a, b, c) <= 0.0f) continue;              // reflex corner
+
+            bool empty = true;
+            for (int j : ring) {
+                if (j == ip || j == ic || j == in) continue;
+                const Vector2& q = poly[j];
+                if ((q.x == a.x && q.y == a.y) || (q.x == b.x && q.y == b.y) || (q.x == c.x && q.y == c.y)) continue;
+                if (InTriangle(q, a, b, c)) { empty = false; break; }
+            }
+            if (!empty) continue;
+
+            tris.push_back({ ip, ic, in });
+            ring.erase(ring.begin() + i);
+            clipped = true;
+            break;
+        }
+        if (!clipped || ++guard > poly.size() * poly.size()) return false;  // not a simple polygon
+    }
+    tris.push_back({ ring[0], ring[1], ring[2] });
+    return true;
+}
+
+static bool IsConvexPiece(const std::vector<Vector2>& poly, const std::vector<int>& piece) {
+    const size_t n = piece.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (Cross(poly[piece[i]], poly[piece[(i + 1) % n]], poly[piece[(i + 2) % n]]) < -1e-4f) return false;
+    }
+    return true;
+}
+
+// Glue B onto A across the shared edge a->b (a->b in A, b->a in B).
+static std::vector<int> MergeAcross(const std::vector<int>& A, size_t edgeA,
+                                    const std::vector<int>& B, size_t edgeB) {
+    std::vector<int> merged;
+    merged.reserve(A.size() + B.size() - 2);
+    // A from b around to a (all of A)
+    for (size_t k = 0; k < A.size(); ++k) merged.push_back(A[(edgeA + 1 + k) % A.size()]);
+    // B strictly between a and b
+    for (size_t k = 2; k < B.size(); ++k) merged.push_back(B[(edgeB + k) % B.size()]);
+    return merged;
+}
+
+std::vector<std::vector<Vector2>> Decompose(const std::vector<Vector2>& outline) {
+    std::vector<Vector2> poly = CleanOutline(outline);
+    if (poly.size() < 3) return {};
+    if (IsConvex(poly)) return { poly };
+
+    std::vector<std::vector<int>> pieces;
+    if (!Triangulate(poly, pieces)) {
+        TraceLog(LOG_WARNING, "SHAPE: outline with %d vertices is not simple, using its convex hull", int(poly.size()));
+        return { ConvexHull(poly) };
+    }
+
+    // Hertel-Mehlhorn: drop inessential diagonals until none is left
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < pieces.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < pieces.size() && !merged; ++j) {
+                const auto& A = pieces[i];
+                const auto& B = pieces[j];
+                for (size_t ea = 0; ea < A.size() && !merged; ++ea) {
+                    int a = A[ea], b = A[(ea + 1) % A.size()];
+                    for (size_t eb = 0; eb < B.size(); ++eb) {
+                        if (B[eb] != b || B[(eb + 1) % B.size()] != a) continue;
+                        std::vector<int> candidate = MergeAcross(A, ea, B, eb);
+                        if (IsConvexPiece(poly, candidate)) {
+                            pieces[i] = std::move(candidate);
+                            pieces.erase(pieces.begin() + j);
+                            merged = true;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<Vector2>> out;
+    out.reserve(pieces.size());
+    for (const auto& piece : pieces) {
+        std::vector<Vector2> verts;
+        verts.reserve(piece.size());
+        for (int idx : piece) verts.push_back(poly[idx]);
+        out.push_back(CleanOutline(verts));      // merged pieces may carry collinear points
+    }
+    return out;
+}
+
+} // namespace ShapeDecomposition
+
 // --- ShapeParser Implementation ---
 namespace ShapeParser {
 
@@ -147,69 +456,76 @@ std::vector<Vector2> ParseVerticesFromString(const std::string& verticesLine) {
 }
 
 
+// "Key: { x,y }" → {x, y}
+static bool ParseBracedPair(const std::string& line, Vector2& out) {
+    size_t open = line.find('{'), comma = line.find(',', open), close = line.find('}', comma);
+    if (open == std::string::npos || comma == std::string::npos || close == std::string::npos) return false;
+    try {
+        out.x = std::stof(line.substr(open + 1, comma - open - 1));
+        out.y = std::stof(line.substr(comma + 1, close - comma - 1));
+        return true;
+    } catch (const std::exception&) {
+        TraceLog(LOG_WARNING, "PARSER: Malformed pair: '%s'", line.c_str());
+        return false;
+    }
+}
+
+static std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\n\r\f\v");
+    if (b == std::string::npos) return {};
+    size_t e = s.find_last_not_of(" \t\n\r\f\v");
+    return s.substr(b, e - b + 1);
+}
+
 CollisionShape LoadFromPhysicsEditor(const std::string& fileContent, const std::string& bodyName, const Vector2& imageSize) {
     CollisionShape shape;
     shape.name = bodyName;
     std::stringstream ss(fileContent);
     std::string line;
 
-    // --- Conceptual Parsing ---
-    // 1. Find the section for `bodyName`.
-    // 2. Extract `AnchorPointAbs: { ax, ay }` or `AnchorPointRel: { rax, ray }`.
-    //    If Rel, AnchorPointAbs = {rax * imageSize.x, ray * imageSize.y}.
-    //    PhysicsEditor seems to provide AnchorPointAbs directly.
-    //    Example: AnchorPointAbs: { 246.344,247.968 } for "pngwing"
-    Vector2 anchorPointAbs = {0,0}; // Default, should be parsed
-
-    bool inTargetBodySection = false;
-    bool lookingForPolygons = false;
-
-    // Extremely simplified example:
-    if (bodyName == "pngwing") { // Hardcoded for example
-        anchorPointAbs = {246.344f, 247.968f}; // From your example data
-    }
-    // This anchorPointAbs is the pivot in image coordinates (top-left origin).
+    // The body section runs from "Name: <bodyName>" to the next "Name:".
+    // AnchorPointAbs (image pixels, top-left origin) is the pivot; if only
+    // AnchorPointRel is given it is scaled by imageSize. PhysicsEditor's
+    // "Convex sub polygons" are used when present, otherwise the hull
+    // polygon is decomposed by addPolygon().
+    Vector2 anchorAbs = {0,0}, anchorRel = {0,0};
+    bool haveAbs = false, haveRel = false, inBody = false;
+    enum class Section { None, Hull, Convex } section = Section::None;
+    std::vector<std::vector<Vector2>> hull, convex;
 
     while (std::getline(ss, line)) {
-        // Trim whitespace from line
-        line.erase(0, line.find_first_not_of(" \t\n\r\f\v"));
-        line.erase(line.find_last_not_of(" \t\n\r\f\v") + 1);
-
-        if (line.find("Name:        " + bodyName) != std::string::npos) {
-            inTargetBodySection = true;
+        line = Trim(line);
+
+        if (line.rfind("Name:", 0) == 0) {
+            const bool match = Trim(line.substr(5)) == bodyName;
+            if (inBody && !match) break;             // next body – done
+            inBody  = match;
+            section = Section::None;
+            continue;
         }
+        if (!inBody) continue;
 
-        if (!inTargetBodySection) continue;
+        if (line.rfind("AnchorPointAbs:", 0) == 0) { haveAbs = ParseBracedPair(line, anchorAbs); continue; }
+        if (line.rfind("AnchorPointRel:", 0) == 0) { haveRel = ParseBracedPair(line, anchorRel); continue; }
+        if (line.find("Hull polygon:") != std::string::npos)       { section = Section::Hull;   continue; }
+        if (line.find("Convex sub polygons:") != std::string::npos) { section = Section::Convex; continue; }
 
-        // Find anchor point (if not already hardcoded/passed)
-        // Example: if(line.find("AnchorPointAbs:") != std::string::npos) { anchorPointAbs = ParseAnchor(line); }
-
-        if (line.find("Hull polygon:") != std::string::npos || line.find("Convex sub polygons:") != std::string::npos) {
-            lookingForPolygons = true;
-            continue; // Next line has the vertices
-        }
-
-        if (lookingForPolygons && !line.empty() && line.front() == '(') {
-            std::vector<Vector2> rawVertices = ParseVerticesFromString(line);
-            if (!rawVertices.empty()) {
-                std::vector<Vector2> adjustedVertices;
-                adjustedVertices.reserve(rawVertices.size());
-                for (const auto& rv : rawVertices) {
-                    // Adjust vertices to be relative to the anchor point
-                    adjustedVertices.push_back(Vector2Subtract(rv, anchorPointAbs));
-                }
-                shape.addPolygon(adjustedVertices);
-            }
-            // If only taking first polygon list, might set lookingForPolygons = false;
-            // Or continue if multiple "Convex sub polygons" lines follow.
-            // A real parser would handle multiple sub-polygon lines under "Convex sub polygons:".
-            // For "Hull polygon", it's usually one complex polygon that might need decomposition
-            // if it's concave and you're using it directly with SAT. PhysicsEditor provides convex sub-polygons.
+        if (!line.empty() && line.front() == '(' && section != Section::None) {
+            std::vector<Vector2> verts = ParseVerticesFromString(line);
+            if (!verts.empty()) (section == Section::Convex ? convex : hull).push_back(std::move(verts));
+            continue;
         }
+        if (!line.empty()) section = Section::None;  // some other property
+    }
 
-        if (inTargetBodySection && line.empty() && lookingForPolygons) { // End of polygon section for this body
-            // break; // Or reset flags if parsing multiple bodies
-        }
+    Vector2 anchor = haveAbs ? anchorAbs
+                   : haveRel ? Vector2{ anchorRel.x * imageSize.x, anchorRel.y * imageSize.y }
+                   : Vector2{ 0, 0 };
+    for (const auto& poly : convex.empty() ? hull : convex) {
+        std::vector<Vector2> adjusted;
+        adjusted.reserve(poly.size());
+        for (const auto& v : poly) adjusted.push_back(Vector2Subtract(v, anchor));  // relative to the pivot
+        shape.addPolygon(adjusted);
     }
     if (shape.polygons.empty()) {
         TraceLog(LOG_WARNING, "PARSER: No polygons loaded for body '%s'. Check parser logic and data.", bodyName.c_str());
@@ -237,6 +553,14 @@ void ProjectPolygon(const Vector2& axis, const std::vector<Vector2>& worldVertic
     }
 }
 
+void ProjectPolygon(const Vector2& axis, const simd::SoAVertices& worldSoA, float& min, float& max) {
+    if (worldSoA.count == 0) {
+        min = 0; max = 0;
+        return;
+    }
+    simd::ProjectPoints(worldSoA.x.data(), worldSoA.y.data(), worldSoA.padded(), axis.x, axis.y, min, max);
+}
+
 float GetOverlap(float minA, float maxA, float minB, float maxB) {
     return std::max(0.0f, std::min(maxA, maxB) - std::max(minA, minB));
 }
@@ -266,20 +590,41 @@ std::vector<Vector2> GetUniqueAxes(const std::vector<Vector2>& worldVertices) {
     return axes;
 }
 
-bool CheckSATCollision(const ConvexPolygon& polyA, const ConvexPolygon& polyB, Vector2& mtv) {
-    if (polyA.worldVertices.empty() || polyB.worldVertices.empty()) return false;
+// pooled views only carry the SoA copy, embedded polygons both
+static Vector2 VertexOf(const PolygonView& p, size_t i) {
+    return p.x ? Vector2{ p.x[i], p.y[i] } : p.aos[i];
+}
+
+// Projection of a view on one axis: SIMD kernels when the SoA copy exists.
+static void ProjectView(const Vector2& axis, const PolygonView& poly, bool useSoA, float& min, float& max) {
+    if (useSoA) {
+        simd::ProjectPoints(poly.x, poly.y, poly.padded, axis.x, axis.y, min, max);
+        return;
+    }
+    min = Vector2DotProduct(VertexOf(poly, 0), axis);
+    max = min;
+    for (size_t i = 1; i < poly.count; ++i) {
+        float p = Vector2DotProduct(VertexOf(poly, i), axis);
+        if (p < min) min = p;
+        else if (p > max) max = p;
+    }
+}
 
+// Shared SAT core: tests the given (unit) axis sets; on overlap returns the
+// axis of least penetration, oriented from A to B, and the overlap along it.
+// `useSoA` switches the projections to the SIMD kernels.
+static bool SATOnAxes(const PolygonView& polyA, const PolygonView& polyB,
+                      const Vector2* axesA, size_t countA, const Vector2* axesB, size_t countB,
+                      bool useSoA, Vector2& axisOut, float& depthOut) {
     float overlap = std::numeric_limits<float>::infinity();
     Vector2 smallestAxis = {0, 0};
 
-    std::vector<Vector2> axesA = GetUniqueAxes(polyA.worldVertices);
-    std::vector<Vector2> axesB = GetUniqueAxes(polyB.worldVertices);
-
-    auto testAxes = [&](const std::vector<Vector2>& currentAxes) {
-        for (const auto& axis : currentAxes) {
+    auto testAxes = [&](const Vector2* currentAxes, size_t count) {
+        for (size_t k = 0; k < count; ++k) {
+            const Vector2& axis = currentAxes[k];
             float minA, maxA, minB, maxB;
-            ProjectPolygon(axis, polyA.worldVertices, minA, maxA);
-            ProjectPolygon(axis, polyB.worldVertices, minB, maxB);
+            ProjectView(axis, polyA, useSoA, minA, maxA);
+            ProjectView(axis, polyB, useSoA, minB, maxB);
 
             if (maxA < minB - 1e-3f || maxB < minA - 1e-3f) { // Add tolerance for floating point
                 return false; // Found a separating axis
@@ -294,29 +639,176 @@ bool CheckSATCollision(const ConvexPolygon& polyA, const ConvexPolygon& polyB, V
         return true; // No separating axis found in this set
     };
 
-    if (!testAxes(axesA)) return false;
-    if (!testAxes(axesB)) return false;
+    if (!testAxes(axesA, countA)) return false;
+    if (!testAxes(axesB, countB)) return false;
 
     // If we got here, there's a collision.
     // Be sure MTV direction pushes polyA away from polyB.
     // The direction vector from A to B.
-    Vector2 direction = Vector2Subtract(polyB.worldCenter, polyA.worldCenter);
+    Vector2 direction = Vector2Subtract(polyB.center, polyA.center);
     if (Vector2DotProduct(direction, smallestAxis) < 0.0f) {
         smallestAxis = Vector2Negate(smallestAxis); // Reverse direction
     }
-    mtv = Vector2Scale(smallestAxis, overlap);
+    axisOut  = smallestAxis;
+    depthOut = overlap;
+    return true;
+}
+
+static std::vector<Vector2> VerticesOf(const PolygonView& p) {
+    std::vector<Vector2> v(p.count);
+    for (size_t i = 0; i < p.count; ++i) v[i] = VertexOf(p, i);
+    return v;
+}
+
+static bool SATReference(const PolygonView& polyA, const PolygonView& polyB, Vector2& axis, float& depth) {
+    if (polyA.count == 0 || polyB.count == 0 || (!polyA.aos && !polyA.x) || (!polyB.aos && !polyB.x)) return false;
+
+    std::vector<Vector2> axesA = GetUniqueAxes(VerticesOf(polyA));
+    std::vector<Vector2> axesB = GetUniqueAxes(VerticesOf(polyB));
+    return SATOnAxes(polyA, polyB, axesA.data(), axesA.size(), axesB.data(), axesB.size(),
+                     /*useSoA=*/false, axis, depth);
+}
+
+static std::atomic<bool> g_referenceSAT{false};
+
+void SetReferenceSAT(bool on) { g_referenceSAT.store(on, std::memory_order_relaxed); }
+bool ReferenceSATEnabled()    { return g_referenceSAT.load(std::memory_order_relaxed); }
+
+static bool SATCached(const PolygonView& polyA, const PolygonView& polyB, Vector2& axis, float& depth) {
+    if (polyA.count == 0 || polyB.count == 0) return false;
+    if (g_referenceSAT.load(std::memory_order_relaxed)) return SATReference(polyA, polyB, axis, depth);
+
+    // Polygons filled in by hand (localVertices written directly) have no
+    // cached axes – stay correct and take the slow path for them.
+    if (polyA.normalCount == 0 || polyB.normalCount == 0)
+        return SATReference(polyA, polyB, axis, depth);
+
+    const bool useSoA = polyA.x && polyB.x;
+    return SATOnAxes(polyA, polyB, polyA.normals, polyA.normalCount, polyB.normals, polyB.normalCount,
+                     useSoA, axis, depth);
+}
+
+bool CheckSATCollision(const ConvexPolygon& polyA, const ConvexPolygon& polyB, Vector2& mtv) {
+    Vector2 axis; float depth;
+    if (!SATCached(polyA.view(), polyB.view(), axis, depth)) return false;
+    mtv = Vector2Scale(axis, depth);
     return true;
 }
 
-bool CheckShapesCollide(const CollisionShape& shapeA, const CollisionShape& shapeB, Vector2& mtv) {
-    for (const auto& polyA : shapeA.polygons) {
-        for (const auto& polyB : shapeB.polygons) {
-            if (CheckSATCollision(polyA, polyB, mtv)) {
-                return true;
+bool CheckSATCollisionReference(const ConvexPolygon& polyA, const ConvexPolygon& polyB, Vector2& mtv) {
+    Vector2 axis; float depth;
+    if (!SATReference(polyA.view(), polyB.view(), axis, depth)) return false;
+    mtv = Vector2Scale(axis, depth);
+    return true;
+}
+
+static bool BoundsOverlap(const Rectangle& a, const Rectangle& b) {
+    return a.x <= b.x + b.width  && b.x <= a.x + a.width &&
+           a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
+
+bool CheckShapesCollide(const ShapeView& shapeA, const ShapeView& shapeB, ContactManifold& manifold) {
+    PROFILE_ZONE_DETAIL("CheckShapesCollide");
+    PROFILE_COUNT("sat calls", 1);
+    manifold = {};
+    if (shapeA.empty() || shapeB.empty()) return false;
+    const Rectangle boundsB = shapeB.worldBounds();
+    if (!BoundsOverlap(shapeA.worldBounds(), boundsB)) return false;
+
+    for (size_t i = 0; i < shapeA.size(); ++i) {
+        const PolygonView polyA = shapeA.piece(i);
+        // level 1: piece vs the whole other shape
+        if (!BoundsOverlap(polyA.aabb, boundsB)) continue;
+
+        for (size_t j = 0; j < shapeB.size(); ++j) {
+            const PolygonView polyB = shapeB.piece(j);
+            // level 2: piece vs piece, then SAT only on survivors
+            if (!BoundsOverlap(polyA.aabb, polyB.aabb)) continue;
+
+            Vector2 axis; float depth;
+            if (!SATCached(polyA, polyB, axis, depth)) continue;
+
+            if (++manifold.contacts == 1 || depth > manifold.depth) {
+                manifold.normal = axis;
+                manifold.depth  = depth;
+                manifold.pieceA = int(i);
+                manifold.pieceB = int(j);
             }
         }
     }
+    return manifold.contacts > 0;
+}
+
+bool CheckShapesCollide(const ShapeView& shapeA, const ShapeView& shapeB, Vector2& mtv) {
+    ContactManifold manifold;
+    if (!CheckShapesCollide(shapeA, shapeB, manifold)) return false;
+    mtv = manifold.mtv();
+    return true;
+}
+
+bool CheckShapesOverlap(const ShapeView& shapeA, const ShapeView& shapeB) {
+    if (shapeA.empty() || shapeB.empty()) return false;
+    const Rectangle boundsB = shapeB.worldBounds();
+    if (!BoundsOverlap(shapeA.worldBounds(), boundsB)) return false;
+
+    for (size_t i = 0; i < shapeA.size(); ++i) {
+        const PolygonView polyA = shapeA.piece(i);
+        if (!BoundsOverlap(polyA.aabb, boundsB)) continue;
+        for (size_t j = 0; j < shapeB.size(); ++j) {
+            const PolygonView polyB = shapeB.piece(j);
+            if (!BoundsOverlap(polyA.aabb, polyB.aabb)) continue;
+            Vector2 axis; float depth;
+            if (SATCached(polyA, polyB, axis, depth)) return true;   // early out
+        }
+    }
     return false;
 }
 
+// Cyrus-Beck: the ray enters a convex piece at the last edge it crosses inwards
+static bool RayPiece(const PolygonView& poly, Vector2 o, Vector2 d, float maxT, float& t, Vector2& normal) {
+    float tEnter = 0.0f, tExit = maxT;
+    Vector2 nEnter{ -d.x, -d.y };                    // origin inside: hit at 0
+    for (size_t i = 0; i < poly.count; ++i) {
+        const Vector2 a = VertexOf(poly, i);
+        const Vector2 b = VertexOf(poly, (i + 1) % poly.count);
+        Vector2 n{ b.y - a.y, a.x - b.x };          // either winding: orient outwards
+        if (Vector2DotProduct(n, Vector2Subtract(a, poly.center)) < 0.0f) n = Vector2Negate(n);
+
+        const float dist  = Vector2DotProduct(n, Vector2Subtract(o, a));   // > 0: outside this edge
+        const float denom = Vector2DotProduct(n, d);
+        if (denom == 0.0f) {
+            if (dist > 0.0f) return false;            // parallel and outside
+            continue;
+        }
+        const float te = -dist / denom;
+        if (denom < 0.0f) { if (te > tEnter) { tEnter = te; nEnter = n; } }
+        else                tExit = std::min(tExit, te);
+        if (tEnter > tExit) return false;
+    }
+    t      = tEnter;
+    normal = Vector2Normalize(nEnter);
+    return true;
+}
+
+bool RaycastShape(const ShapeView& shape, Vector2 origin, Vector2 dir, float maxDist,
+                  float& dist, Vector2& normal) {
+    if (shape.empty()) return false;
+    float lo = 0.0f, hi = maxDist;
+    if (!RayAABB(origin, dir, shape.worldBounds(), lo, hi)) return false;
+
+    bool hit = false;
+    float best = maxDist;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        const PolygonView poly = shape.piece(i);
+        float t0 = 0.0f, t1 = best;
+        if (poly.count < 3 || !RayAABB(origin, dir, poly.aabb, t0, t1)) continue;
+
+        float t; Vector2 n;
+        if (!RayPiece(poly, origin, dir, best, t, n) || (hit && t >= best)) continue;
+        hit = true; best = t; normal = n;
+    }
+    if (hit) dist = best;
+    return hit;
+}
+
 } // namespace CollisionSystem
\ No newline at end of file
@@ -1,24 +1,104 @@
 #include "entity.hpp"
 
 
-// Inline implementation kept in the header for brevity
-inline void Entity::setTexture(const std::string& path)
+void Entity::setTexture(const std::string& path)
 {
-    if (texture.id) UnloadTexture(texture);
+    setTexture(Assets().texture(path));
+}
+
+void Entity::setTexture(TextureHandle handle)
+{
+    textureRef = std::move(handle);
+    texture    = textureRef.get();
+    textureSrc = { 0, 0, (float)texture.width, (float)texture.height };
+    offset     = { size.x*0.5f, size.y*0.5f };
+}
+
+void Entity::pollTexture()
+{
+    if (!textureRef.ready()) return;
+    const Texture2D& t = textureRef.get();
+    if (t.id == texture.id) return;     // already adopted (or was ready at spawn)
 
-    Image img = LoadImage(path.c_str());
-    ImageResize(&img, (int)size.x, (int)size.y);
-    texture   = LoadTextureFromImage(img);
-    UnloadImage(img);
+    texture = t;
+    fitToTexture({ (float)t.width, (float)t.height });
+}
 
-    offset = { size.x*0.5f, size.y*0.5f };
+void Entity::fitToTexture(Vector2 texSize)
+{
+    size       = texSize;
+    offset     = { size.x*0.5f, size.y*0.5f };
+    textureSrc = { 0, 0, size.x, size.y };
+    markTransformDirty();               // the no-shape AABB fallback uses size
+    onTextureFitted();
+}
+
+void Entity::setShape(ShapeDefPtr def)
+{
+    shapeDef = std::move(def);
+    if (shapePool)
+    {
+        shapePool->release(shapeSlot);
+        shapeSlot = shapeDef ? shapePool->acquire(shapeDef) : ShapePool::INVALID;
+        if (shapeSlot == ShapePool::INVALID) shapePool = nullptr;
+    }
+    else shape = {};                    // re-instantiated lazily if never pooled
+    markTransformDirty();
+}
+
+void Entity::attachShapePool(ShapePool& pool)
+{
+    if (shapePool) return;
+    if (!shapeDef && !shape.polygons.empty()) shapeDef = ShapeDef::FromShape(shape);
+    if (!shapeDef) return;              // no outline – the size fallback needs no pool
+
+    shapeSlot = pool.acquire(shapeDef);
+    shapePool = &pool;
+    shape     = {};                     // the pool holds the world copy now
+    markTransformDirty();
+}
+
+void Entity::detachShapePool()
+{
+    if (!shapePool) return;
+    shapePool->release(shapeSlot);
+    shapePool = nullptr;
+    shapeSlot = ShapePool::INVALID;
+    markTransformDirty();
+}
+
+bool Entity::isTransformDirty() const
+{
+    return transformDirty ||
+           position.x != xformPosition.x || position.y != xformPosition.y ||
+           rotation   != xformRotation   || scale      != xformScale;
 }
 
 void Entity::recalcOverallAABB()
 {
+    // nothing moved since the last call → world vertices & AABB are current
+    if (!isTransformDirty()) return;
+
+    xformPosition  = position;
+    xformRotation  = rotation;
+    xformScale     = scale;
+    transformDirty = false;
+
+    // pooled: the world copy lives in World's ShapePool
+    if (shapePool)
+    {
+        overallAABB = shapePool->transform(shapeSlot, position, rotation, scale);
+        s_transformCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // standalone entity with a shared definition: embed a copy once
+    if (shapeDef && shape.polygons.empty()) shape = shapeDef->instantiate();
+
     // update the SAT shape with the current position, rotation, and scale:
     // (scale is optional, but we use it for the sake of completeness)
     shape.updateWorldVertices(position, rotation, scale);
+    s_transformCount.fetch_add(1, std::memory_order_relaxed);
 
     // If we have no polygons, fall back to the visual rectangle:
     if (shape.polygons.empty())
@@ -29,28 +109,26 @@ void Entity::recalcOverallAABB()
         return;
     }
 
-    // Otherwise scan every vertex in every convex polygon:
-    bool first = true;
-    float minX=0, minY=0, maxX=0, maxY=0;
-    for (auto& poly : shape.polygons)
+    // Otherwise the shape already merged its per-piece bounds:
+    overallAABB = shape.worldBounds;
+}
+
+
+void Entity::submit(RenderQueue& q) const
+{
+    const Texture2D& tex = drawTexture();
+    if (textureRef.loading())   // placeholder: mark the spot until the upload lands
     {
-        for (auto& v : poly.worldVertices)
-        {
-            if (first)
-            {
-                minX = maxX = v.x;
-                minY = maxY = v.y;
-                first = false;
-            }
-            else
-            {
-                minX = std::min(minX, v.x);
-                minY = std::min(minY, v.y);
-                maxX = std::max(maxX, v.x);
-                maxY = std::max(maxY, v.y);
-            }
-        }
+        q.push(tex, { 0, 0, (float)tex.width, (float)tex.height }, overallAABB, { 0, 0 }, 0.0f, 0, tint);
+        return;
     }
-    overallAABB = { minX, minY, maxX - minX, maxY - minY };
+    Rectangle src = textureSrc.width > 0 ? textureSrc : Rectangle{ 0, 0, size.x, size.y };
+    Rectangle dst{ renderPos.x, renderPos.y, size.x, size.y };
+    q.push(tex, src, dst, offset, renderRot, 0, tint);
 }
 
+void Entity::drawDebug() const
+{
+    DrawRectangleLinesEx(overallAABB, 2.0f, BLUE);
+    collider().drawLines(RED);
+}
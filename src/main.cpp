@@ -31,81 +31,94 @@
  ************************************************************************************/
 
 #include <raylib.h>
+#include <cstring>
 #include "world.hpp"
 #include "basicship.hpp"
 #include "playercontroller.hpp"
 #include "blb63dreadnaught.hpp"
+#include "textureatlas.hpp"
 
 
 /* Runs from the last tests performed on collision*/
-int main()
+// `--record <file>`: log the session for Aspace_replay (see replay.hpp)
+int main(int argc, char** argv)
 {
+    const char* recordPath = nullptr;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], "--record")) recordPath = argv[i + 1];
+
     InitWindow(2000, 1500, "Hello World!");
+    PROFILE_THREAD("main");
     SetTargetFPS(60);
 
-    World world("rsc/Environment/white_local_star_2.png");
+    {   // everything holding GPU resources is released before CloseWindow()
+        ReplayRecorder recorder;   // outlives the world that writes into it
+        World world("rsc/Environment/white_local_star_2.png");
+        if (recordPath) world.record(&recorder);
 
-    Texture2D hullTex   = util::LoadTextureNN(
-        "rsc/Main Ship/Main Ship - Bases/PNGs/Main Ship - Base - Full health.png",
-        3);
-    Texture2D flamesTex = util::LoadTextureNN(
-        "rsc/Main Ship/Main Ship - Engine Effects/PNGs/"
-        "Main Ship - Engines - Base Engine - Idle.png",
-        3);
-    Texture2D poweringTex = util::LoadTextureNN(
-        "rsc/Main Ship/Main Ship - Engine Effects/PNGs/"
-        "Main Ship - Engines - Base Engine - Powering.png",
-        3);
+        // ship sprites: packed once at startup, one texture per atlas page
+        TextureAtlas atlas;
+        atlas.addDirectory("rsc/Main Ship", 3);
+        atlas.addDirectory("rsc/EnemyFleet_1");
+        atlas.build();
 
-    Texture2D DarthDreadBigB = util::LoadTextureNN("rsc/DarthBigB.png", 0.5f);
+        AtlasSprite hull       = atlas.sprite("Main Ship - Base - Full health");
+        AtlasSprite flames     = atlas.sprite("Main Ship - Engines - Base Engine - Idle");
+        AtlasSprite powering   = atlas.sprite("Main Ship - Engines - Base Engine - Powering");
+        AtlasSprite baseEngine = atlas.sprite("Main Ship - Engines - Base Engine");
 
-    Texture2D dreadNaught = util::LoadTextureNN("rsc/BLB63dreadnaught.png");
+        // shared, ref-counted: released when the last ship using them goes.
+        // Decoded in the background – the ships show a placeholder until then.
+        TextureHandle DarthDreadBigB = Assets().textureAsync("rsc/DarthBigB.png", 0.5f);
 
-    Texture2D baseEngine = util::LoadTextureNN("rsc/Main Ship/Main Ship - Engines/PNGs/Main Ship - Engines - Base Engine.png", 3);
+        TextureHandle dreadNaught = Assets().textureAsync("rsc/BLB63dreadnaught.png");
 
-    Animation flamesIdle = util::MakeStripAnimation(
-        "idle", flamesTex, 3, 0.1f);
+        AnimationClipPtr flamesIdle = util::MakeStripAnimation(
+            "idle", flames.src, 3, 0.1f);
 
-    Animation flamesPowering = util::MakeStripAnimation(
-        "powering", poweringTex, 4, 0.1f);
+        AnimationClipPtr flamesPowering = util::MakeStripAnimation(
+            "powering", powering.src, 4, 0.1f);
 
-    Animation baseEngineAnim = util::MakeStripAnimation(
-        "baseEngine", baseEngine, 1, 0.1f, Animation::LoopMode::Once);
+        AnimationClipPtr baseEngineAnim = util::MakeStripAnimation(
+            "baseEngine", baseEngine.src, 1, 0.1f, AnimationClip::LoopMode::Once);
 
-    auto& player = world.spawn<BasicShip>({ 500, 300 }, hullTex);
-    player.addPart(&flamesTex, flamesIdle,
-        Vector2{0, 0}, -1);
-    player.addPart(&poweringTex, flamesPowering,
+        auto& player = world.spawn<BasicShip>({ 500, 300 }, hull);
+        player.setMouseSteering(true);
+        player.addPart(flames.texture, flamesIdle,
             Vector2{0, 0}, -1);
+        player.addPart(powering.texture, flamesPowering,
+                Vector2{0, 0}, -1);
 
-    player.addPart(&baseEngine, baseEngineAnim,
-            Vector2{0, 0}, -1);
+        player.addPart(baseEngine.texture, baseEngineAnim,
+                Vector2{0, 0}, -1);
     
-    world.setCameraTarget(&player);
-
-    world.spawn<BLB63DreadNaught>({ 800, 600 }, DarthDreadBigB);
-    world.spawn<BLB63DreadNaught>({ 1000, 800 }, dreadNaught);
-
-    while (!WindowShouldClose())
-    {
-        float dt = GetFrameTime();
-
-        Vector2 worldMouse =
-            util::ScreenToWorld(GetMousePosition(), world.getCamera());
-        player.setTarget(worldMouse);
-
-        world.update(dt);
-
-        BeginDrawing();
-            world.draw();
-        EndDrawing();
+        world.setCameraTarget(&player);
+
+        world.spawn<BLB63DreadNaught>({ 800, 600 }, DarthDreadBigB);
+        world.spawn<BLB63DreadNaught>({ 1000, 800 }, dreadNaught);
+
+        while (!WindowShouldClose())
+        {
+            float dt = GetFrameTime();
+
+            // one input snapshot per frame, shared by everything in the sim
+            InputState input = InputState::Capture(world.getCamera());
+            if (input.toggleDebug) world.setDebugDraw(!world.debugDrawEnabled());
+            if (input.toggleProfiler) world.setProfilerOverlay(!world.profilerOverlayEnabled());
+            if (input.captureTrace) Profile().beginCapture("aspace_trace.json", 300);   // ~5 s at 60 FPS
+
+            world.update(dt, input);
+            Assets().pumpUploads();   // a bounded number of GPU uploads per frame
+
+            BeginDrawing();
+                world.draw();
+            EndDrawing();
+            PROFILE_FRAME();
+        }
+        if (recordPath) recorder.save(recordPath);
     }
 
-    UnloadTexture(hullTex);
-    UnloadTexture(flamesTex);
-    UnloadTexture(poweringTex);
-    UnloadTexture(dreadNaught);
-    UnloadTexture(baseEngine);
+    Assets().shutdown();
     CloseWindow();
     return 0;
 }
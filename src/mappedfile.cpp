@@ -0,0 +1,83 @@
+#include "mappedfile.hpp"
+
+#if defined(_WIN32)
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept
+{
+    if (this != &o) {
+        close();
+        bytes  = o.bytes;  o.bytes  = nullptr;
+        length = o.length; o.length = 0;
+        handle = o.handle; o.handle = nullptr;
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER sz{};
+    if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) { CloseHandle(file); return false; }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);                       // the mapping keeps the file alive
+    if (!mapping) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); return false; }
+
+    bytes  = static_cast<const unsigned char*>(view);
+    length = size_t(sz.QuadPart);
+    handle = mapping;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (bytes)  UnmapViewOfFile(bytes);
+    if (handle) CloseHandle(static_cast<HANDLE>(handle));
+    bytes = nullptr; length = 0; handle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+
+    void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);                             // the mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+
+    bytes  = static_cast<const unsigned char*>(view);
+    length = size_t(st.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+    bytes = nullptr; length = 0; handle = nullptr;
+}
+
+#endif
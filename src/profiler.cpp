@@ -0,0 +1,261 @@
+#include "profiler.hpp"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// names are literals, but keep the JSON valid whatever they hold
+void WriteJsonString(std::FILE* f, const char* s)
+{
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) std::fputc(*s, f);
+    }
+    std::fputc('"', f);
+}
+
+} // namespace
+
+// --- Recording ---
+Profiler::ThreadLog& Profiler::local()
+{
+    // one log per (thread, profiler); there is only ever one profiler
+    static thread_local ThreadLog* log = nullptr;
+    if (log) return *log;
+
+    std::lock_guard<std::mutex> lk(regMx);
+    threads.push_back(std::make_unique<ThreadLog>());
+    log      = threads.back().get();
+    log->tid = uint32_t(threads.size());
+    return *log;
+}
+
+void Profiler::zone(const char* name, Clock::time_point begin, Clock::time_point end, int depth)
+{
+    ThreadLog& log = local();
+    std::lock_guard<std::mutex> lk(log.mx);   // only frame() ever contends
+    log.events.push_back({ name, ns(begin), ns(end), depth });
+}
+
+int Profiler::counterId(const char* name, bool gauge)
+{
+    std::lock_guard<std::mutex> lk(regMx);
+    const int n = slotCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+        if (std::strcmp(slots[i].name, name) == 0) return i;
+    if (n == int(MAX_COUNTERS)) return -1;
+
+    slots[n].name  = name;
+    slots[n].gauge = gauge;
+    slotCount.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+void Profiler::count(int id, int64_t n)
+{
+    if (id < 0) return;
+    local().sums[id].fetch_add(n, std::memory_order_relaxed);
+}
+
+void Profiler::setValue(int id, int64_t v)
+{
+    if (id < 0) return;
+    slots[id].value.store(v, std::memory_order_relaxed);
+}
+
+void Profiler::nameThread(const char* name)
+{
+    ThreadLog& log = local();
+    std::lock_guard<std::mutex> lk(log.mx);
+    log.name = name;
+}
+
+// --- Frame boundary ---
+void Profiler::frame()
+{
+    const int64_t now  = ns(Clock::now());
+    const int     slot = int(frameIndex % WINDOW);
+    const int     nCounters = slotCount.load(std::memory_order_acquire);
+
+    // 1. drain every thread's log
+    int64_t sums[MAX_COUNTERS] = {};
+    scratch.clear();
+    {
+        std::lock_guard<std::mutex> reg(regMx);
+        for (auto& t : threads)
+        {
+            std::lock_guard<std::mutex> lk(t->mx);
+            if (capturing())
+                for (const Event& e : t->events) captured.push_back({ t->tid, e });
+            scratch.insert(scratch.end(), t->events.begin(), t->events.end());
+            t->events.clear();
+            for (int c = 0; c < nCounters; ++c) sums[c] += t->sums[c].exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 2. zones: this frame's total per name into the history ring.
+    //    By start time, so a new zone is listed after its parent.
+    std::sort(scratch.begin(), scratch.end(), [](const Event& l, const Event& r) {
+        return l.begin != r.begin ? l.begin < r.begin : l.depth < r.depth;
+    });
+    for (ZoneHistory& h : history) { h.ms[slot] = 0.0; h.calls[slot] = 0; }
+    for (const Event& e : scratch)
+    {
+        size_t idx;
+        auto p = byPtr.find(e.name);
+        if (p != byPtr.end()) idx = p->second;
+        else
+        {
+            auto [it, fresh] = byName.try_emplace(e.name, history.size());
+            if (fresh) {
+                history.emplace_back();
+                history.back().stats.name  = e.name;
+                history.back().stats.depth = e.depth;
+            }
+            idx = it->second;
+            byPtr.emplace(e.name, idx);
+        }
+        ZoneHistory& h = history[idx];
+        h.ms[slot]    += double(e.end - e.begin) * 1e-6;
+        h.calls[slot] += 1;
+        h.stats.depth  = std::min(h.stats.depth, e.depth);
+    }
+
+    const int filled = int(std::min<uint64_t>(frameIndex + 1, WINDOW));
+    zoneStats.clear();
+    for (ZoneHistory& h : history)
+    {
+        double sum = 0.0, worst = 0.0, calls = 0.0;
+        for (int i = 0; i < filled; ++i) { sum += h.ms[i]; worst = std::max(worst, h.ms[i]); calls += h.calls[i]; }
+        h.stats.avgMs = sum / filled;
+        h.stats.maxMs = worst;
+        h.stats.calls = calls / filled;
+        zoneStats.push_back(h.stats);
+    }
+
+    // 3. counters and gauges
+    counterStats.clear();
+    for (int c = 0; c < nCounters; ++c)
+    {
+        CounterSlot& s = slots[c];
+        const int64_t v = s.gauge ? s.value.load(std::memory_order_relaxed) : sums[c];
+        s.hist[slot] = v;
+        double sum = 0.0;
+        for (int i = 0; i < filled; ++i) sum += double(s.hist[i]);
+        counterStats.push_back({ s.name, s.gauge, sum / filled, v });
+        if (capturing()) capturedCounts.push_back({ c, now, v });
+#if defined(ASPACE_TRACY)
+        TracyPlot(s.name, v);
+#endif
+    }
+
+    // 4. frame time (the first frame only starts the clock)
+    if (frameIndex > 0) frameHist[slot] = double(now - frameBegin) * 1e-6;
+    double sum = 0.0, worst = 0.0;
+    for (int i = 0; i < filled; ++i) { sum += frameHist[i]; worst = std::max(worst, frameHist[i]); }
+    frameAvgMs   = sum / filled;
+    frameWorstMs = worst;
+    frameBegin   = now;
+    ++frameIndex;
+
+    if (captureLeft > 0 && --captureLeft == 0) writeCapture();
+
+#if defined(ASPACE_TRACY)
+    FrameMark;
+#endif
+}
+
+// --- Chrome trace capture ---
+bool Profiler::beginCapture(std::string path, int frames)
+{
+    if (!Enabled() || capturing() || frames <= 0) return false;
+    capturePath = std::move(path);
+    captureLeft = frames;
+    captured.clear();
+    capturedCounts.clear();
+    return true;
+}
+
+void Profiler::writeCapture()
+{
+    std::FILE* f = std::fopen(capturePath.c_str(), "wb");
+    if (!f) {
+        TraceLog(LOG_WARNING, "PROFILE: could not write %s", capturePath.c_str());
+        return;
+    }
+
+    // complete events ("X") in microseconds, counters as "C", thread names as metadata
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    bool first = true;
+    auto sep = [&]{ std::fputs(first ? "" : ",\n", f); first = false; };
+    {
+        std::lock_guard<std::mutex> reg(regMx);
+        for (auto& t : threads)
+        {
+            std::lock_guard<std::mutex> lk(t->mx);
+            if (!t->name) continue;
+            sep();
+            std::fprintf(f, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", t->tid);
+            WriteJsonString(f, t->name);
+            std::fputs("}}", f);
+        }
+    }
+    for (const auto& [tid, e] : captured)
+    {
+        sep();
+        std::fputs("{\"ph\":\"X\",\"cat\":\"aspace\",\"name\":", f);
+        WriteJsonString(f, e.name);
+        std::fprintf(f, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     tid, double(e.begin) * 1e-3, double(e.end - e.begin) * 1e-3);
+    }
+    for (const Sample& s : capturedCounts)
+    {
+        sep();
+        std::fputs("{\"ph\":\"C\",\"name\":", f);
+        WriteJsonString(f, slots[s.id].name);
+        std::fprintf(f, ",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%lld}}", double(s.ts) * 1e-3, (long long)s.value);
+    }
+    std::fputs("\n]}\n", f);
+    std::fclose(f);
+
+    TraceLog(LOG_INFO, "PROFILE: wrote %zu zones to %s", captured.size(), capturePath.c_str());
+    captured.clear();
+    capturedCounts.clear();
+}
+
+// --- Overlay ---
+void Profiler::drawOverlay(int x, int y, int fontSize) const
+{
+    const int line = fontSize + 4;
+    const int rows = 2 + int(zoneStats.size()) + (counterStats.empty() ? 0 : 1 + int(counterStats.size()));
+    DrawRectangle(x - 6, y - 4, 34 * fontSize, rows * line + 8, Color{ 0, 0, 0, 160 });
+
+    if (!Enabled()) {
+        DrawText("profiler compiled out (ASPACE_PROFILE=0)", x, y, fontSize, RAYWHITE);
+        return;
+    }
+    DrawText(TextFormat("frame %.2f ms avg  %.2f max  (%d frames)%s", frameAvgMs, frameWorstMs, WINDOW,
+                        capturing() ? "  [capturing]" : ""),
+             x, y, fontSize, RAYWHITE);
+    y += line;
+    DrawText("zone                         avg ms   max ms   calls", x, y, fontSize, GRAY);
+    y += line;
+    for (const ZoneStats& z : zoneStats)
+    {
+        DrawText(z.name, x + z.depth * fontSize, y, fontSize, RAYWHITE);
+        DrawText(TextFormat("%7.3f  %7.3f  %6.1f", z.avgMs, z.maxMs, z.calls), x + 15 * fontSize, y, fontSize, RAYWHITE);
+        y += line;
+    }
+    if (counterStats.empty()) return;
+    DrawText("counter                      avg / frame   last", x, y, fontSize, GRAY);
+    y += line;
+    for (const CounterStats& c : counterStats)
+    {
+        DrawText(c.name, x, y, fontSize, RAYWHITE);
+        DrawText(TextFormat("%10.1f  %8lld", c.avg, (long long)c.last), x + 15 * fontSize, y, fontSize, RAYWHITE);
+        y += line;
+    }
+}
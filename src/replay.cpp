@@ -0,0 +1,210 @@
+#include "replay.hpp"
+#include "entity.hpp"
+#include "mappedfile.hpp"
+#include "simdkernels.hpp"
+#include <cstdio>
+
+namespace {
+
+// bit-exact: -0 ≠ +0, a NaN equals itself
+bool Same(float a, float b)             { return std::memcmp(&a, &b, sizeof a) == 0; }
+bool Same(Vector2 a, Vector2 b)         { return Same(a.x, b.x) && Same(a.y, b.y); }
+bool Same(const Rectangle& a, const Rectangle& b)
+{
+    return Same(a.x, b.x) && Same(a.y, b.y) && Same(a.width, b.width) && Same(a.height, b.height);
+}
+
+uint8_t Buttons(const InputState& in)
+{
+    return uint8_t(in.mouseLeft << 0 | in.mouseRight << 1 | in.ctrl << 2 |
+                   in.toggleDebug << 3 | in.toggleProfiler << 4 | in.captureTrace << 5);
+}
+
+} // namespace
+
+// --- File ---
+bool ReplayLog::save(const std::string& path) const
+{
+    std::vector<uint8_t> head;
+    ReplayWriter w(head);
+    w.u32(MAGIC);
+    w.u16(VERSION);
+    w.u16(0);                       // reserved
+    w.u64(seed);
+    w.f32(tickDt);
+    w.u32(threads);
+    w.u64(ticks);
+    w.str(grid);
+    w.str(simd);
+    w.u64(events.size());
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        TraceLog(LOG_WARNING, "REPLAY: could not write %s", path.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(head.data(), 1, head.size(), f) == head.size();
+    ok = ok && std::fwrite(events.data(), 1, events.size(), f) == events.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (ok) TraceLog(LOG_INFO, "REPLAY: wrote %llu ticks (%zu bytes) to %s",
+                     (unsigned long long)ticks, head.size() + events.size(), path.c_str());
+    return ok;
+}
+
+bool ReplayLog::load(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path)) return false;
+
+    ReplayReader r(file.data(), file.size());
+    if (r.u32() != MAGIC || r.u16() != VERSION) {
+        TraceLog(LOG_WARNING, "REPLAY: %s is not a version %d replay log", path.c_str(), VERSION);
+        return false;
+    }
+    r.u16();
+    ReplayLog in;
+    in.seed    = r.u64();
+    in.tickDt  = r.f32();
+    in.threads = r.u32();
+    in.ticks   = r.u64();
+    in.grid    = r.str();
+    in.simd    = r.str();
+    const uint64_t n = r.u64();
+    if (!r.ok() || n > file.size()) return false;
+
+    const uint8_t* body = file.data() + (file.size() - n);
+    if (!r.sub(size_t(n)).ok() || !r.atEnd()) return false;   // truncated or trailing bytes
+    in.events.assign(body, body + n);
+    *this = std::move(in);
+    return true;
+}
+
+// --- Recording ---
+void ReplayRecorder::begin(uint64_t seed, float tickDt, const char* grid, unsigned threads)
+{
+    out.seed    = seed;
+    out.tickDt  = tickDt;
+    out.grid    = grid;
+    out.simd    = simd::BackendName();
+    out.threads = threads;
+    out.ticks   = 0;
+    out.events.clear();
+    pending.clear();
+    kinds.clear();
+    lastIn   = {};
+    lastView = {};
+    unknown  = 0;
+}
+
+void ReplayRecorder::spawned(const Entity& e, Vector2 spawnPos)
+{
+    // size now: it is what the constructor saw, before any texture swap
+    pending.push_back({ &e, spawnPos, e.size });
+}
+
+uint16_t ReplayRecorder::kindId(const char* name)
+{
+    for (size_t i = 0; i < kinds.size(); ++i)
+        if (kinds[i] == name) return uint16_t(i);
+    kinds.emplace_back(name);
+    w.u8(uint8_t(ReplayTag::Kind));
+    w.str(kinds.back());
+    return uint16_t(kinds.size() - 1);
+}
+
+void ReplayRecorder::writeSpawn(const Pending& p)
+{
+    const Entity& e    = *p.e;
+    const char*   kind = e.replayKind();
+    if (!kind) { ++unknown; kind = ""; }
+    const uint16_t id = kindId(kind);
+
+    std::vector<uint8_t> extra;
+    ReplayWriter ew(extra);
+    e.saveReplay(ew);
+
+    w.u8(uint8_t(ReplayTag::Spawn));
+    w.u16(id);
+    handle(e.handle());
+    w.vec2(p.spawnPos);
+    w.vec2(p.size);
+    // pose and the common knobs as setup left them
+    w.vec2(e.getPosition());
+    w.f32(e.rotation);
+    w.f32(e.scale);
+    w.f64(e.speed);
+    w.u8(uint8_t(e.isCollidable << 0 | e.aiLod << 1 | e.isAlive << 2));
+    w.u16(uint16_t(extra.size()));
+    w.raw(extra);
+}
+
+void ReplayRecorder::flush()
+{
+    for (const Pending& p : pending) writeSpawn(p);
+    pending.clear();
+}
+
+void ReplayRecorder::despawned(EntityHandle h)
+{
+    flush();
+    w.u8(uint8_t(ReplayTag::Despawn));
+    handle(h);
+}
+
+void ReplayRecorder::teleported(EntityHandle h, Vector2 pos)
+{
+    flush();
+    w.u8(uint8_t(ReplayTag::Teleport));
+    handle(h);
+    w.vec2(pos);
+}
+
+void ReplayRecorder::resized(EntityHandle h, Vector2 size)
+{
+    flush();
+    w.u8(uint8_t(ReplayTag::Resize));
+    handle(h);
+    w.vec2(size);
+}
+
+void ReplayRecorder::reseeded(uint64_t seed)
+{
+    flush();
+    w.u8(uint8_t(ReplayTag::Seed));
+    w.u64(seed);
+}
+
+void ReplayRecorder::tick(const InputState& in, const Rectangle& lodView)
+{
+    flush();
+    uint8_t mask = 0;
+    if (!Same(in.mouseScreen, lastIn.mouseScreen)) mask |= MOUSE_SCREEN;
+    if (!Same(in.mouseWorld,  lastIn.mouseWorld))  mask |= MOUSE_WORLD;
+    if (!Same(in.wheel,       lastIn.wheel))       mask |= WHEEL;
+    if (Buttons(in) != Buttons(lastIn))            mask |= BUTTONS;
+    if (!Same(in.screenSize,  lastIn.screenSize))  mask |= SCREEN;
+    if (!Same(lodView, lastView))                  mask |= VIEW;
+
+    w.u8(uint8_t(ReplayTag::Tick));
+    w.u8(mask);
+    if (mask & MOUSE_SCREEN) w.vec2(in.mouseScreen);
+    if (mask & MOUSE_WORLD)  w.vec2(in.mouseWorld);
+    if (mask & WHEEL)        w.f32(in.wheel);
+    if (mask & BUTTONS)      w.u8(Buttons(in));
+    if (mask & SCREEN)       w.vec2(in.screenSize);
+    if (mask & VIEW)         { w.vec2({ lodView.x, lodView.y }); w.vec2({ lodView.width, lodView.height }); }
+    lastIn   = in;
+    lastView = lodView;
+}
+
+void ReplayRecorder::tickDone(uint64_t stateHash)
+{
+    w.u64(stateHash);
+    ++out.ticks;
+}
+
+void ReplayRecorder::frameEnd()
+{
+    flush();
+    w.u8(uint8_t(ReplayTag::FrameEnd));
+}
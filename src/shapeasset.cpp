@@ -0,0 +1,160 @@
+#include "shapeasset.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+bool HostIsLittleEndian()
+{
+    const uint32_t one = 1;
+    unsigned char b;
+    std::memcpy(&b, &one, 1);
+    return b == 1;
+}
+
+Rectangle BoundsOf(const std::vector<Vector2>& pts)
+{
+    if (pts.empty()) return {0, 0, 0, 0};
+    float minX = pts[0].x, maxX = pts[0].x, minY = pts[0].y, maxY = pts[0].y;
+    for (const auto& p : pts) {
+        minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y); maxY = std::max(maxY, p.y);
+    }
+    return { minX, minY, maxX - minX, maxY - minY };
+}
+
+std::vector<Vector2> ReadPairs(const float* src, size_t count)
+{
+    std::vector<Vector2> out(count);
+    for (size_t i = 0; i < count; ++i) out[i] = { src[i*2], src[i*2 + 1] };
+    return out;
+}
+
+} // namespace
+
+// --- Loading ---
+std::shared_ptr<const ShapeAsset> ShapeAsset::Load(const std::string& path)
+{
+    PROFILE_ZONE("asset: shape load");
+    static std::mutex mx;
+    static std::unordered_map<std::string, std::weak_ptr<const ShapeAsset>> cache;
+
+    std::lock_guard<std::mutex> lk(mx);
+    if (auto hit = cache[path].lock()) return hit;
+
+    std::shared_ptr<ShapeAsset> asset(new ShapeAsset);
+    if (!asset->map(path)) return nullptr;
+    cache[path] = asset;
+    return asset;
+}
+
+bool ShapeAsset::map(const std::string& path)
+{
+    sourcePath = path;
+    if (!HostIsLittleEndian()) {
+        TraceLog(LOG_WARNING, "SHAPE: .ashape files are little-endian only (%s)", path.c_str());
+        return false;
+    }
+    if (!file.open(path)) {
+        TraceLog(LOG_WARNING, "SHAPE: could not open %s", path.c_str());
+        return false;
+    }
+
+    const size_t size = file.size();
+    const unsigned char* base = file.data();
+    if (size < sizeof(AshapeHeader)) { TraceLog(LOG_WARNING, "SHAPE: %s is truncated", path.c_str()); return false; }
+
+    header = reinterpret_cast<const AshapeHeader*>(base);
+    if (std::memcmp(header->magic, "ASHP", 4) != 0 || header->version != ASHAPE_VERSION) {
+        TraceLog(LOG_WARNING, "SHAPE: %s is not a v%u .ashape file", path.c_str(), ASHAPE_VERSION);
+        return false;
+    }
+
+    // every section must lie inside the file, every piece inside its section
+    const size_t piecesAt   = sizeof(AshapeHeader);
+    const size_t verticesAt = piecesAt   + size_t(header->pieceCount)  * sizeof(AshapePiece);
+    const size_t normalsAt  = verticesAt + size_t(header->vertexCount) * 2 * sizeof(float);
+    const size_t end        = normalsAt  + size_t(header->normalCount) * 2 * sizeof(float);
+    if (end > size) { TraceLog(LOG_WARNING, "SHAPE: %s is truncated", path.c_str()); return false; }
+
+    pieces   = reinterpret_cast<const AshapePiece*>(base + piecesAt);
+    vertices = reinterpret_cast<const float*>(base + verticesAt);
+    normals  = reinterpret_cast<const float*>(base + normalsAt);
+
+    for (uint32_t i = 0; i < header->pieceCount; ++i) {
+        const AshapePiece& p = pieces[i];
+        if (uint64_t(p.firstVertex) + p.vertexCount > header->vertexCount ||
+            uint64_t(p.firstNormal) + p.normalCount > header->normalCount || p.vertexCount < 3) {
+            TraceLog(LOG_WARNING, "SHAPE: %s has a corrupt piece %u", path.c_str(), i);
+            return false;
+        }
+    }
+    sharedDef = ShapeDef::FromShape(instantiate(GetFileNameWithoutExt(path.c_str())));
+    return true;
+}
+
+CollisionShape ShapeAsset::instantiate(const std::string& name) const
+{
+    CollisionShape shape;
+    shape.name = name.empty() ? sourcePath : name;
+    shape.polygons.resize(header->pieceCount);
+    for (uint32_t i = 0; i < header->pieceCount; ++i) {
+        const AshapePiece& p = pieces[i];
+        shape.polygons[i].setPrecomputed(ReadPairs(vertices + size_t(p.firstVertex) * 2, p.vertexCount),
+                                         ReadPairs(normals  + size_t(p.firstNormal) * 2, p.normalCount),
+                                         { p.center[0], p.center[1] });
+    }
+    return shape;
+}
+
+// --- Writing (tools) ---
+bool ShapeAsset::Write(const std::string& path, const CollisionShape& shape)
+{
+    if (!HostIsLittleEndian()) return false;
+
+    AshapeHeader header{};
+    std::memcpy(header.magic, "ASHP", 4);
+    header.version = ASHAPE_VERSION;
+
+    std::vector<AshapePiece> pieces;
+    std::vector<float>       verts, norms;
+    std::vector<Vector2>     all;
+    for (const auto& poly : shape.polygons) {
+        if (poly.localVertices.size() < 3) continue;
+        if (!ShapeDecomposition::IsConvex(poly.localVertices)) {
+            TraceLog(LOG_WARNING, "SHAPE: refusing to write a concave piece to %s", path.c_str());
+            return false;
+        }
+        AshapePiece p{};
+        p.firstVertex = uint32_t(verts.size() / 2);
+        p.vertexCount = uint32_t(poly.localVertices.size());
+        p.firstNormal = uint32_t(norms.size() / 2);
+        p.normalCount = uint32_t(poly.localNormals.size());
+        p.center[0]   = poly.localCenter.x;
+        p.center[1]   = poly.localCenter.y;
+        Rectangle b   = BoundsOf(poly.localVertices);
+        p.bounds[0] = b.x; p.bounds[1] = b.y; p.bounds[2] = b.width; p.bounds[3] = b.height;
+        for (const auto& v : poly.localVertices) { verts.push_back(v.x); verts.push_back(v.y); all.push_back(v); }
+        for (const auto& n : poly.localNormals)  { norms.push_back(n.x); norms.push_back(n.y); }
+        pieces.push_back(p);
+    }
+    header.pieceCount  = uint32_t(pieces.size());
+    header.vertexCount = uint32_t(verts.size() / 2);
+    header.normalCount = uint32_t(norms.size() / 2);
+    Rectangle b = BoundsOf(all);
+    header.bounds[0] = b.x; header.bounds[1] = b.y; header.bounds[2] = b.width; header.bounds[3] = b.height;
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) { TraceLog(LOG_WARNING, "SHAPE: cannot write %s", path.c_str()); return false; }
+    bool ok = std::fwrite(&header, sizeof header, 1, f) == 1;
+    if (ok && !pieces.empty()) ok = std::fwrite(pieces.data(), sizeof(AshapePiece), pieces.size(), f) == pieces.size();
+    if (ok && !verts.empty())  ok = std::fwrite(verts.data(), sizeof(float), verts.size(), f) == verts.size();
+    if (ok && !norms.empty())  ok = std::fwrite(norms.data(), sizeof(float), norms.size(), f) == norms.size();
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
@@ -0,0 +1,215 @@
+#include "shapedef.hpp"
+#include <raymath.h>
+#include <algorithm>
+#include <cmath>
+
+// --- ShapeDef ---
+
+ShapeDefPtr ShapeDef::FromShape(const CollisionShape& shape)
+{
+    auto def = std::make_shared<ShapeDef>();
+    def->name = shape.name;
+
+    bool first = true;
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (const auto& authored : shape.polygons)
+    {
+        if (authored.localVertices.empty()) continue;
+
+        // hand-filled polygons carry no normals / centre yet
+        const ConvexPolygon rebuilt = authored.localNormals.empty() ? ConvexPolygon(authored.localVertices) : ConvexPolygon{};
+        const ConvexPolygon& poly   = authored.localNormals.empty() ? rebuilt : authored;
+
+        simd::SoAVertices soa;
+        soa.assign(poly.localVertices);
+
+        Piece p;
+        p.soa         = uint32_t(def->x.size());
+        p.padded      = uint32_t(soa.padded());
+        p.count       = uint32_t(soa.count);
+        p.normal      = uint32_t(def->normals.size());
+        p.normalCount = uint32_t(poly.localNormals.size());
+        p.center      = poly.localCenter;
+
+        float pminX = poly.localVertices[0].x, pmaxX = pminX;
+        float pminY = poly.localVertices[0].y, pmaxY = pminY;
+        for (const auto& v : poly.localVertices) {
+            pminX = std::min(pminX, v.x); pmaxX = std::max(pmaxX, v.x);
+            pminY = std::min(pminY, v.y); pmaxY = std::max(pmaxY, v.y);
+        }
+        p.bounds = { pminX, pminY, pmaxX - pminX, pmaxY - pminY };
+        if (first) { minX = pminX; minY = pminY; maxX = pmaxX; maxY = pmaxY; first = false; }
+        else {
+            minX = std::min(minX, pminX); minY = std::min(minY, pminY);
+            maxX = std::max(maxX, pmaxX); maxY = std::max(maxY, pmaxY);
+        }
+
+        def->x.insert(def->x.end(), soa.x.begin(), soa.x.end());
+        def->y.insert(def->y.end(), soa.y.begin(), soa.y.end());
+        def->normals.insert(def->normals.end(), poly.localNormals.begin(), poly.localNormals.end());
+        def->pieces.push_back(p);
+    }
+    def->bounds = { minX, minY, maxX - minX, maxY - minY };
+    return def;
+}
+
+CollisionShape ShapeDef::instantiate() const
+{
+    CollisionShape shape;
+    shape.name = name;
+    shape.polygons.resize(pieces.size());
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+        const Piece& p = pieces[i];
+        std::vector<Vector2> verts(p.count);
+        for (uint32_t k = 0; k < p.count; ++k) verts[k] = { x[p.soa + k], y[p.soa + k] };
+        shape.polygons[i].setPrecomputed(std::move(verts),
+                                         { normals.begin() + p.normal, normals.begin() + p.normal + p.normalCount },
+                                         p.center);
+    }
+    return shape;
+}
+
+size_t ShapeDef::vertexCount() const
+{
+    size_t n = 0;
+    for (const auto& p : pieces) n += p.count;
+    return n;
+}
+
+// --- ShapePool ---
+
+ShapePool::Slot ShapePool::acquire(ShapeDefPtr def)
+{
+    if (!def) return INVALID;
+
+    // a released instance with the same array footprint can be rebased in place
+    Slot slot = INVALID;
+    for (size_t i = 0; i < freeSlots.size(); ++i)
+    {
+        const ShapeDef& old = *instances[freeSlots[i]].def;
+        if (old.x.size() == def->x.size() && old.normals.size() == def->normals.size() &&
+            old.pieces.size() == def->pieces.size())
+        {
+            slot = freeSlots[i];
+            freeSlots[i] = freeSlots.back();
+            freeSlots.pop_back();
+            break;
+        }
+    }
+
+    if (slot == INVALID)
+    {
+        slot = Slot(instances.size());
+        Instance in;
+        in.soa    = uint32_t(worldX.size());
+        in.normal = uint32_t(worldNormals.size());
+        in.piece  = uint32_t(worldPieces.size());
+        instances.push_back(in);
+        worldX.resize(worldX.size() + def->x.size());
+        worldY.resize(worldY.size() + def->y.size());
+        worldNormals.resize(worldNormals.size() + def->normals.size());
+        worldPieces.resize(worldPieces.size() + def->pieces.size());
+    }
+
+    Instance& in = instances[slot];
+    in.def    = std::move(def);
+    in.live   = true;
+    in.bounds = {};
+    for (size_t k = 0; k < in.def->pieces.size(); ++k)
+    {
+        const ShapeDef::Piece& lp = in.def->pieces[k];
+        PieceInstance& wp = worldPieces[in.piece + k];
+        wp = {};
+        wp.soa         = in.soa + lp.soa;
+        wp.padded      = lp.padded;
+        wp.count       = lp.count;
+        wp.normal      = in.normal + lp.normal;
+        wp.normalCount = lp.normalCount;
+    }
+    // until the first transform the world copy is the local outline
+    std::copy(in.def->x.begin(), in.def->x.end(), worldX.begin() + in.soa);
+    std::copy(in.def->y.begin(), in.def->y.end(), worldY.begin() + in.soa);
+    std::copy(in.def->normals.begin(), in.def->normals.end(), worldNormals.begin() + in.normal);
+    return slot;
+}
+
+void ShapePool::release(Slot slot)
+{
+    if (slot >= instances.size() || !instances[slot].live) return;
+    instances[slot].live = false;      // keep `def`: acquire() compares footprints with it
+    freeSlots.push_back(slot);
+}
+
+Rectangle ShapePool::transform(Slot slot, Vector2 position, float rotationDegrees, float scale)
+{
+    Instance& in = instances[slot];
+    const ShapeDef& d = *in.def;
+
+    const float rotationRadians = rotationDegrees * DEG2RAD;
+    const float cosTheta = cosf(rotationRadians);
+    const float sinTheta = sinf(rotationRadians);
+
+    bool first = true;
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (size_t k = 0; k < d.pieces.size(); ++k)
+    {
+        const ShapeDef::Piece& lp = d.pieces[k];
+        PieceInstance& wp = worldPieces[in.piece + k];
+        float* wx = worldX.data() + wp.soa;
+        float* wy = worldY.data() + wp.soa;
+
+        simd::TransformPoints(d.x.data() + lp.soa, d.y.data() + lp.soa, wx, wy, lp.padded,
+                              cosTheta, sinTheta, scale, position.x, position.y);
+
+        // Rotate the cached axes (no scale, no renormalisation needed)
+        for (uint32_t i = 0; i < lp.normalCount; ++i) {
+            const Vector2 n = d.normals[lp.normal + i];
+            worldNormals[wp.normal + i] = { n.x * cosTheta - n.y * sinTheta,
+                                            n.x * sinTheta + n.y * cosTheta };
+        }
+
+        float pminX = wx[0], pmaxX = pminX, pminY = wy[0], pmaxY = pminY;
+        for (uint32_t i = 1; i < lp.count; ++i) {
+            pminX = std::min(pminX, wx[i]); pmaxX = std::max(pmaxX, wx[i]);
+            pminY = std::min(pminY, wy[i]); pmaxY = std::max(pmaxY, wy[i]);
+        }
+        wp.aabb = { pminX, pminY, pmaxX - pminX, pmaxY - pminY };
+
+        // same arithmetic as ConvexPolygon::transform – results match bit for bit
+        Vector2 scaledCenter = Vector2Scale(lp.center, scale);
+        wp.center = Vector2Add(position, { scaledCenter.x * cosTheta - scaledCenter.y * sinTheta,
+                                           scaledCenter.x * sinTheta + scaledCenter.y * cosTheta });
+
+        // union of the piece rectangles, as CollisionShape::updateWorldVertices does
+        const Rectangle& b = wp.aabb;
+        if (first) { minX = b.x; minY = b.y; maxX = b.x + b.width; maxY = b.y + b.height; first = false; }
+        else {
+            minX = std::min(minX, b.x);           minY = std::min(minY, b.y);
+            maxX = std::max(maxX, b.x + b.width); maxY = std::max(maxY, b.y + b.height);
+        }
+    }
+    in.bounds = { minX, minY, maxX - minX, maxY - minY };
+    return in.bounds;
+}
+
+ShapeView ShapePool::view(Slot slot) const
+{
+    const Instance& in = instances[slot];
+    ShapeView v;
+    v.pieces     = worldPieces.data() + in.piece;
+    v.pieceCount = in.def->pieces.size();
+    v.x          = worldX.data();
+    v.y          = worldY.data();
+    v.normals    = worldNormals.data();
+    v.bounds     = in.bounds;
+    return v;
+}
+
+size_t ShapePool::bytesInUse() const
+{
+    return (worldX.capacity() + worldY.capacity()) * sizeof(float) +
+           worldNormals.capacity() * sizeof(Vector2) +
+           worldPieces.capacity()  * sizeof(PieceInstance) +
+           instances.capacity()    * sizeof(Instance);
+}
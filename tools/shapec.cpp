@@ -0,0 +1,75 @@
+/***********************************************************************************
+ *                              [SHAPE COMPILER]
+ * @brief Converts a PhysicsEditor plain text export into a binary .ashape file.
+ * @details Runs the slow part of shape loading once, offline: parse, anchor
+ *          adjust, convex decomposition, SAT normals. The game then maps the
+ *          result with ShapeAsset::Load and copies floats – zero parsing.
+ * @details --dump prints an existing .ashape (pieces, vertex counts, bounds).
+ *
+ * Usage:  Aspace_shapec <input.txt> <body name> <out.ashape> [image w] [image h]
+ *         Aspace_shapec --dump <file.ashape>
+ *         (image size only matters for AnchorPointRel exports)
+ ************************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "collisionshapes.hpp"
+#include "shapeasset.hpp"
+
+namespace {
+
+int Dump(const std::string& path)
+{
+    auto asset = ShapeAsset::Load(path);
+    if (!asset) { std::fprintf(stderr, "shapec: cannot read %s\n", path.c_str()); return 1; }
+
+    Rectangle b = asset->localBounds();
+    std::printf("%s: %zu piece(s), %zu vertices, bounds (%.1f, %.1f) %.1f x %.1f\n",
+                path.c_str(), asset->pieceCount(), asset->vertexCount(), b.x, b.y, b.width, b.height);
+    for (size_t i = 0; i < asset->pieceCount(); ++i)
+    {
+        const AshapePiece& p = asset->piece(i);
+        std::printf("  [%zu] %u verts, %u normals, centre (%.1f, %.1f), bounds (%.1f, %.1f) %.1f x %.1f\n",
+                    i, p.vertexCount, p.normalCount, p.center[0], p.center[1],
+                    p.bounds[0], p.bounds[1], p.bounds[2], p.bounds[3]);
+    }
+    return 0;
+}
+
+int Compile(const std::string& in, const std::string& body, const std::string& out, Vector2 imageSize)
+{
+    std::ifstream file(in);
+    if (!file) { std::fprintf(stderr, "shapec: cannot open %s\n", in.c_str()); return 1; }
+    std::stringstream text;
+    text << file.rdbuf();
+
+    CollisionShape shape = ShapeParser::LoadFromPhysicsEditor(text.str(), body, imageSize);
+    if (shape.polygons.empty()) { std::fprintf(stderr, "shapec: no polygons for body '%s'\n", body.c_str()); return 1; }
+    if (!ShapeAsset::Write(out, shape)) { std::fprintf(stderr, "shapec: cannot write %s\n", out.c_str()); return 1; }
+
+    std::printf("shapec: %s (%s) -> %s, %zu convex piece(s)\n", in.c_str(), body.c_str(), out.c_str(), shape.polygons.size());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    if (argc == 3 && std::string(argv[1]) == "--dump") return Dump(argv[2]);
+    if (argc == 4 || argc == 6)
+    {
+        Vector2 imageSize{ 0, 0 };
+        if (argc == 6) imageSize = { float(std::atof(argv[4])), float(std::atof(argv[5])) };
+        return Compile(argv[1], argv[2], argv[3], imageSize);
+    }
+
+    std::fprintf(stderr, "usage: %s <input.txt> <body name> <out.ashape> [image w] [image h]\n"
+                         "       %s --dump <file.ashape>\n", argv[0], argv[0]);
+    return 2;
+}